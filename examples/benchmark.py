@@ -1,22 +1,38 @@
 import argparse
 import pystk
+import resource
 from time import time
 
+
+def max_rss_mb():
+    # ru_maxrss is in kB on Linux
+    return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 1024.
+
 if __name__ == "__main__":
     parser = argparse.ArgumentParser()
     parser.add_argument('-t', '--track')
     parser.add_argument('-k', '--kart', default='')
     parser.add_argument('-s', '--step_size', type=float)
     parser.add_argument('-n', '--num_player', type=int, default=1)
+    parser.add_argument('-c', '--config', choices=['ld', 'sd', 'hd', 'none', 'none_full'], nargs='+',
+                        default=['ld', 'sd', 'hd', 'none', 'none_full'],
+                        help='Graphics configs to compare. Peak memory is only meaningful for the first config, '
+                             'run one config per process to compare it. none() runs in physics-only mode, '
+                             'none_full is none() with physics_only=False (all meshes and textures are loaded).')
     args = parser.parse_args()
 
-    for config in [pystk.GraphicsConfig.ld(), pystk.GraphicsConfig.sd(), pystk.GraphicsConfig.hd(), None]:
-        print(config)
+    def none_full():
+        config = pystk.GraphicsConfig.none()
+        config.physics_only = False
+        return config
+
+    configs = {'ld': pystk.GraphicsConfig.ld, 'sd': pystk.GraphicsConfig.sd, 'hd': pystk.GraphicsConfig.hd,
+               'none': pystk.GraphicsConfig.none, 'none_full': none_full}
+    for name in args.config:
+        config = configs[name]()
+        print(name)
         t0 = time()
-        render = True
-        if config is None:
-            config = pystk.GraphicsConfig.none()
-        else:
+        if config.render:
             config.screen_width = 320
             config.screen_height = 240
         pystk.init(config)
@@ -55,6 +71,7 @@ if __name__ == "__main__":
         print('  start', start_time)
         print('  restart', restart_time / 5.)
         print('  step FPS', 500. / step_time)
+        print('  peak memory (MB)', max_rss_mb())
 
         race.stop()
         del race
@@ -0,0 +1,37 @@
+"""
+Measure the cost of a physics tick under dense collision loads. Many AI karts are packed into a soccer field or battle
+arena, where they keep bumping into each other, the ball, items and physical objects. Graphics are disabled, so the
+time per tick is simulation only. The 'Physics' profiler marker isolates the bullet step and collision handling.
+"""
+import argparse
+import pystk
+from time import time
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-t', '--track', default='soccer_field')
+    parser.add_argument('-m', '--mode', choices=['soccer', 'ffa'], default='soccer')
+    parser.add_argument('-k', '--num_kart', type=int, nargs='+', default=[2, 8, 16, 32])
+    parser.add_argument('--ticks', type=int, default=1000, help='Ticks per race')
+    args = parser.parse_args()
+
+    mode = pystk.RaceConfig.RaceMode.SOCCER if args.mode == 'soccer' else pystk.RaceConfig.RaceMode.FREE_FOR_ALL
+
+    pystk.init(pystk.GraphicsConfig.none())
+    print('%6s %12s %12s' % ('karts', 'us / tick', 'physics us'))
+    for num_kart in args.num_kart:
+        config = pystk.RaceConfig(track=args.track, mode=mode, num_kart=num_kart)
+        config.players[0].controller = pystk.PlayerConfig.Controller.AI_CONTROL
+        race = pystk.Race(config)
+        race.start()
+        pystk.profiler.reset()
+        pystk.profiler.enable()
+        t0 = time()
+        race.step_ticks(args.ticks, render=False)
+        dt = time() - t0
+        pystk.profiler.disable()
+        physics = pystk.profiler.stats().get('Physics', {'mean': 0})
+        print('%6d %12.1f %12.1f' % (num_kart, 1e6 * dt / args.ticks, 1e3 * physics['mean']))
+        race.stop()
+        del race
+    pystk.clean()
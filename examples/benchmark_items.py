@@ -0,0 +1,38 @@
+"""
+Measure the cost of a physics tick depending on the number of karts and items. AI karts in a battle arena drop
+bubble gums and bananas, so the number of items grows during the run. Graphics are disabled, so the time per tick is
+simulation only.
+"""
+import argparse
+import pystk
+from time import time
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-t', '--track', default='battleisland')
+    parser.add_argument('-k', '--num_kart', type=int, nargs='+', default=[1, 4, 8, 16])
+    parser.add_argument('--ticks', type=int, default=200, help='Ticks per measurement')
+    parser.add_argument('--rounds', type=int, default=10, help='Measurements per race')
+    parser.add_argument('-j', '--kart_threads', type=int, default=0, help='Threads to prepare kart updates')
+    args = parser.parse_args()
+
+    graphics_config = pystk.GraphicsConfig.none()
+    graphics_config.kart_threads = args.kart_threads
+    pystk.init(graphics_config)
+    print('%6s %6s %12s' % ('karts', 'items', 'us / tick'))
+    for num_kart in args.num_kart:
+        config = pystk.RaceConfig(track=args.track, mode=pystk.RaceConfig.RaceMode.FREE_FOR_ALL,
+                                  num_kart=num_kart)
+        config.players[0].controller = pystk.PlayerConfig.Controller.AI_CONTROL
+        race = pystk.Race(config)
+        race.start()
+        state = pystk.WorldState()
+        for r in range(args.rounds):
+            t0 = time()
+            race.step_ticks(args.ticks, render=False)
+            dt = time() - t0
+            state.update()
+            print('%6d %6d %12.1f' % (num_kart, len(state.items), 1e6 * dt / args.ticks))
+        race.stop()
+        del race
+    pystk.clean()
@@ -0,0 +1,68 @@
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+from time import time
+
+
+def child(args):
+    import pystk
+    t0 = time()
+    config = getattr(pystk.GraphicsConfig, args.config)()
+    config.screen_width = 320
+    config.screen_height = 240
+    pystk.init(config)
+    init_time, t0 = time() - t0, time()
+
+    config = pystk.RaceConfig()
+    if args.track is not None:
+        config.track = args.track
+    race = pystk.Race(config)
+    race.start()
+    race.step()
+    start_time = time() - t0
+    race.stop()
+    del race
+    pystk.clean()
+    print(json.dumps({'init': init_time, 'start': start_time}))
+
+
+def run(args, cache_dir):
+    # The shader program and texture caches live in $XDG_CACHE_HOME/supertuxkart
+    env = dict(os.environ, XDG_CACHE_HOME=cache_dir)
+    cmd = [sys.executable, __file__, '--child', '-c', args.config] + (['-t', args.track] if args.track else [])
+    out = subprocess.run(cmd, env=env, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, check=True).stdout
+    return json.loads(out.decode().strip().split('\n')[-1])
+
+
+def report(name, times):
+    n = len(times)
+    print('%-6s init %6.2f s   race start %6.2f s' % (name, sum(t['init'] for t in times) / n,
+                                                       sum(t['start'] for t in times) / n))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description='Startup time of fresh processes with an empty (cold) and a filled '
+                                                 '(warm) shader program and texture cache.')
+    parser.add_argument('-t', '--track')
+    parser.add_argument('-c', '--config', choices=['ld', 'sd', 'hd'], default='hd')
+    parser.add_argument('-n', '--num_runs', type=int, default=3)
+    parser.add_argument('--child', action='store_true', help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    if args.child:
+        child(args)
+        sys.exit(0)
+
+    cold = []
+    for it in range(args.num_runs):
+        with tempfile.TemporaryDirectory() as cache_dir:
+            cold.append(run(args, cache_dir))
+    with tempfile.TemporaryDirectory() as cache_dir:
+        # Fill the cache once
+        run(args, cache_dir)
+        warm = [run(args, cache_dir) for it in range(args.num_runs)]
+    report('cold', cold)
+    report('warm', warm)
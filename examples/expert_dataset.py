@@ -0,0 +1,29 @@
+"""
+Record the built-in AI on a list of tracks with the EpisodeRunner and save the observations, actions and rewards.
+All episodes run in C++, python only sees the final arrays.
+"""
+import argparse
+import numpy as np
+import pystk
+from time import time
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-t', '--track', nargs='+', default=['lighthouse', 'zengarden', 'hacienda'])
+    parser.add_argument('-k', '--num_kart', type=int, default=4)
+    parser.add_argument('-s', '--max_steps', type=int, default=2000)
+    parser.add_argument('--seeds', type=int, default=1, help='Episodes per track')
+    parser.add_argument('-o', '--output', default='expert.npz')
+    args = parser.parse_args()
+
+    pystk.init(pystk.GraphicsConfig.none())
+    configs = [pystk.RaceConfig(track=t, num_kart=args.num_kart, laps=1, seed=s)
+               for t in args.track for s in range(args.seeds)]
+    runner = pystk.EpisodeRunner(configs, max_steps=args.max_steps)
+    t0 = time()
+    data = runner.run()
+    dt = time() - t0
+    steps = int(data['length'].sum())
+    print('%d episodes, %d steps in %0.1fs (%0.0f steps / s)' % (len(configs), steps, dt, steps / dt))
+    np.savez(args.output, **data)
+    pystk.clean()
@@ -0,0 +1,77 @@
+"""
+Check that races are bit-exact reproducible: the same seed and the same actions have to produce the same world states,
+after a restart, after a save_state / load_state and in a freshly started race. A different seed should change the race.
+Exits with a non-zero status if any of these checks fails.
+"""
+import argparse
+import hashlib
+import pickle
+import sys
+
+import numpy as np
+import pystk
+
+
+def rollout(race, actions):
+    digests = []
+    for a, s in actions:
+        race.step(pystk.Action(acceleration=a, steer=s, fire=s > 0.9))
+        w = pystk.WorldState()
+        w.update()
+        digests.append(hashlib.sha1(pickle.dumps(w)).hexdigest())
+    return digests
+
+
+def first_mismatch(a, b):
+    for i, (x, y) in enumerate(zip(a, b)):
+        if x != y:
+            return i
+    return None
+
+
+def run(race_config, actions):
+    race = pystk.Race(race_config)
+    race.start()
+    first = rollout(race, actions)
+    race.restart()
+    restarted = rollout(race, actions)
+
+    race.restart()
+    half = len(actions) // 2
+    rollout(race, actions[:half])
+    state = race.save_state()
+    second_half = rollout(race, actions[half:])
+    race.load_state(state)
+    reloaded = rollout(race, actions[half:])
+    race.stop()
+    del race
+    return first, restarted, second_half, reloaded
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-t', '--track', default='lighthouse')
+    parser.add_argument('-n', '--num_kart', type=int, default=4)
+    parser.add_argument('--steps', type=int, default=500)
+    parser.add_argument('--seed', type=int, default=0)
+    args = parser.parse_args()
+
+    pystk.init(pystk.GraphicsConfig.none())
+    actions = np.random.RandomState(0).rand(args.steps, 2) * [1, 2] - [0, 1]
+
+    config = pystk.RaceConfig(track=args.track, num_kart=args.num_kart, seed=args.seed)
+    first, restarted, second_half, reloaded = run(config, actions)
+    fresh, _, _, _ = run(config, actions)
+    config.seed = args.seed + 1
+    other_seed, _, _, _ = run(config, actions)
+    pystk.clean()
+
+    failed = False
+    for name, a, b in [('restart', first, restarted), ('new race', first, fresh),
+                       ('load_state', second_half, reloaded)]:
+        i = first_mismatch(a, b)
+        print('%-10s: %s' % (name, 'identical' if i is None else 'diverged at step %d' % i))
+        failed = failed or i is not None
+    print('%-10s: %s' % ('other seed', 'identical' if first == other_seed else 'differs'))
+    failed = failed or first == other_seed
+    sys.exit(1 if failed else 0)
@@ -6,13 +6,16 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include "episode.hpp"
 #include "pickle.hpp"
 #include "pystk.hpp"
 #include "state.hpp"
+#include "vector_race.hpp"
 #include "view.hpp"
 #include "utils/constants.hpp"
 #include "utils/objecttype.h"
 #include "utils/log.hpp"
+#include "utils/profiler.hpp"
 
 #ifdef WIN32
 #include <Windows.h>
@@ -25,7 +28,9 @@ PYBIND11_MAKE_OPAQUE(std::vector<PySTKPlayerConfig>);
 
 void path_and_init(const PySTKGraphicsConfig & config) {
     auto pystk_data = py::module::import("pystk_data"), os = py::module::import("os");
-    PySTKRace::init(config, py::cast<std::string>(py::str(pystk_data.attr("data_dir"))));
+    std::string data_dir = py::cast<std::string>(py::str(pystk_data.attr("data_dir")));
+    py::gil_scoped_release release;
+    PySTKRace::init(config, data_dir);
 }
 PYBIND11_MODULE(pystk, m) {
     m.doc() = "Python SuperTuxKart interface";
@@ -81,7 +86,7 @@ PYBIND11_MODULE(pystk, m) {
     {
         py::class_<PySTKGraphicsConfig, std::shared_ptr<PySTKGraphicsConfig>> cls(m, "GraphicsConfig", "SuperTuxKart graphics configuration.");
         
-        cls.def(py::init<int, int, int, bool, bool, bool, bool, bool, int, bool, bool, bool, bool, bool, bool, int, bool>(), py::arg("screen_width") = 600, py::arg("screen_height") = 400, py::arg("display_adapter") = 0, py::arg("glow") = false, py::arg("") = true, py::arg("") = true, py::arg("") = true, py::arg("") = true, py::arg("particles_effects") = 2, py::arg("animated_characters") = true, py::arg("motionblur") = true, py::arg("mlaa") = true, py::arg("texture_compression") = true, py::arg("ssao") = true, py::arg("degraded_IBL") = false, py::arg("high_definition_textures") = 2 | 1, py::arg("render") = true)
+        cls.def(py::init<int, int, int, bool, bool, bool, bool, bool, int, bool, bool, bool, bool, bool, bool, int, bool, int, bool, bool, bool, int, int, bool>(), py::arg("screen_width") = 600, py::arg("screen_height") = 400, py::arg("display_adapter") = 0, py::arg("glow") = false, py::arg("") = true, py::arg("") = true, py::arg("") = true, py::arg("") = true, py::arg("particles_effects") = 2, py::arg("animated_characters") = true, py::arg("motionblur") = true, py::arg("mlaa") = true, py::arg("texture_compression") = true, py::arg("ssao") = true, py::arg("degraded_IBL") = false, py::arg("high_definition_textures") = 2 | 1, py::arg("render") = true, py::arg("readback_delay") = 0, py::arg("read_color") = true, py::arg("read_depth") = true, py::arg("read_instance") = true, py::arg("track_cache_mb") = 0, py::arg("kart_threads") = 0, py::arg("physics_only") = false)
         .def_readwrite("screen_width", &PySTKGraphicsConfig::screen_width, "Width of the rendering surface")
         .def_readwrite("screen_height", &PySTKGraphicsConfig::screen_height, "Height of the rendering surface")
         .def_readwrite("display_adapter", &PySTKGraphicsConfig::display_adapter, "GPU to use (Linux only)")
@@ -98,7 +103,14 @@ PYBIND11_MODULE(pystk, m) {
         .def_readwrite("ssao", &PySTKGraphicsConfig::ssao, "Enable screen space ambient occlusion")
         .def_readwrite("degraded_IBL", &PySTKGraphicsConfig::degraded_IBL, "Disable specular IBL")
         .def_readwrite("high_definition_textures", &PySTKGraphicsConfig::high_definition_textures, "Enable high definition textures 0 / 2")
-        .def_readwrite("render", &PySTKGraphicsConfig::render, "Is rendering enabled?");
+        .def_readwrite("render", &PySTKGraphicsConfig::render, "Is rendering enabled?")
+        .def_readwrite("readback_delay", &PySTKGraphicsConfig::readback_delay, "Number of steps render_data lags behind the simulation. A delay of 1 or 2 lets the GPU to CPU transfer of a frame overlap with the next steps.")
+        .def_readwrite("read_color", &PySTKGraphicsConfig::read_color, "Transfer the color image to RenderData.image")
+        .def_readwrite("read_depth", &PySTKGraphicsConfig::read_depth, "Transfer the depth image to RenderData.depth")
+        .def_readwrite("read_instance", &PySTKGraphicsConfig::read_instance, "Transfer the instance labels to RenderData.instance")
+        .def_readwrite("track_cache_mb", &PySTKGraphicsConfig::track_cache_mb, "Memory budget in MB to keep recently used tracks loaded between races, 0 disables the track cache")
+        .def_readwrite("kart_threads", &PySTKGraphicsConfig::kart_threads, "Number of threads used to prepare the kart updates (terrain raycasts and AI look-ahead) of each step in parallel, 0 or 1 updates karts on the calling thread only")
+        .def_readwrite("physics_only", &PySTKGraphicsConfig::physics_only, "Only load what the simulation needs: meshes are not uploaded to the GPU, textures, the sky and fonts are not loaded, and no shader is compiled. Requires render=False, set in GraphicsConfig.none()");
         add_pickle(cls);
         
         cls.def_static("hd", &PySTKGraphicsConfig::hd, "High-definitaiton graphics settings");
@@ -144,7 +156,7 @@ PYBIND11_MODULE(pystk, m) {
         .def_readwrite("track", &PySTKRaceConfig::track, "Track name")
         .def_readwrite("reverse", &PySTKRaceConfig::reverse, "Reverse the track")
         .def_readwrite("laps", &PySTKRaceConfig::laps, "Number of laps the race runs for")
-        .def_readwrite("seed", &PySTKRaceConfig::seed, "Random seed")
+        .def_readwrite("seed", &PySTKRaceConfig::seed, "Random seed, all random decisions of the race (items, powerups and AI) are derived from it")
         .def_readwrite("num_kart", &PySTKRaceConfig::num_kart, "Total number of karts, fill the race with num_kart - len(players) AI karts")
         .def_readwrite("step_size", &PySTKRaceConfig::step_size, "Game time between different step calls");
         add_pickle(cls);
@@ -154,9 +166,11 @@ PYBIND11_MODULE(pystk, m) {
     {
         py::class_<PySTKRenderData, std::shared_ptr<PySTKRenderData> > cls(m, "RenderData", "SuperTuxKart rendering output");
         cls
-       .def_property_readonly("image", [](const PySTKRenderData & rd) { return rd.color_buf_->get(); }, "Color image of the kart (memoryview[uint8] screen_height x screen_width x 3)")
-       .def_property_readonly("depth", [](const PySTKRenderData & rd) { return rd.depth_buf_->get(); }, "Depth image of the kart (memoryview[float] screen_height x screen_width)")
-       .def_property_readonly("instance", [](const PySTKRenderData & rd) { return rd.instance_buf_->get(); }, "Instance labels (memoryview[uint32] screen_height x screen_width)");
+       .def_property_readonly("image", [](const PySTKRenderData & rd) -> py::object { if (rd.color_buf_) return rd.color_buf_->get(); return py::none(); }, "Color image of the kart (memoryview[uint8] screen_height x screen_width x 3), None unless GraphicsConfig.read_color")
+       .def_property_readonly("depth", [](const PySTKRenderData & rd) -> py::object { if (rd.depth_buf_) return rd.depth_buf_->get(); return py::none(); }, "Depth image of the kart (memoryview[float] screen_height x screen_width), None unless GraphicsConfig.read_depth")
+       .def_property_readonly("instance", [](const PySTKRenderData & rd) -> py::object { if (rd.instance_buf_) return rd.instance_buf_->get(); return py::none(); }, "Instance labels (memoryview[uint32] screen_height x screen_width), None unless GraphicsConfig.read_instance")
+       .def("ready", &PySTKRenderData::ready, "Has the GPU finished transferring this frame? Accessing image, depth or instance before that blocks.")
+       .def("wait", &PySTKRenderData::wait, py::call_guard<py::gil_scoped_release>(), "Block until the GPU finished transferring this frame");
 ;
 //        add_pickle(cls);
     }
@@ -182,12 +196,16 @@ PYBIND11_MODULE(pystk, m) {
     {
         py::class_<PySTKRace, std::shared_ptr<PySTKRace> >(m, "Race", "The SuperTuxKart race instance")
         .def(py::init<const PySTKRaceConfig &>(),py::arg("config"))
-        .def("restart", &PySTKRace::restart,"Restart the current track. Use this function if the race config does not change, instead of creating a new SuperTuxKart object")
-        .def("start", &PySTKRace::start,"start the race")
-        .def("step", (bool (PySTKRace::*)(const std::vector<PySTKAction> &)) &PySTKRace::step, py::arg("action"), "Take a step with an action per agent")
-        .def("step", (bool (PySTKRace::*)(const PySTKAction &)) &PySTKRace::step, py::arg("action"), "Take a step with an action for agent 0")
-        .def("step", (bool (PySTKRace::*)()) &PySTKRace::step, "Take a step without changing the action")
+        .def("restart", &PySTKRace::restart, py::call_guard<py::gil_scoped_release>(), "Restart the current track. Use this function if the race config does not change, instead of creating a new SuperTuxKart object")
+        .def("start", &PySTKRace::start, py::call_guard<py::gil_scoped_release>(), "start the race")
+        .def("step", (bool (PySTKRace::*)(const std::vector<PySTKAction> &, int)) &PySTKRace::step, py::arg("action"), py::arg("frame_skip") = 1, py::call_guard<py::gil_scoped_release>(), "Take a step with an action per agent. frame_skip > 1 simulates frame_skip steps, but only updates the graphics and renders the last one.")
+        .def("step", (bool (PySTKRace::*)(const PySTKAction &, int)) &PySTKRace::step, py::arg("action"), py::arg("frame_skip") = 1, py::call_guard<py::gil_scoped_release>(), "Take a step with an action for agent 0")
+        .def("step", (bool (PySTKRace::*)(int)) &PySTKRace::step, py::arg("frame_skip") = 1, py::call_guard<py::gil_scoped_release>(), "Take a step without changing the action")
+        .def("step_ticks", (bool (PySTKRace::*)(int, const std::vector<std::vector<PySTKAction> > &, bool)) &PySTKRace::stepTicks, py::arg("ticks"), py::arg("schedule"), py::arg("render") = true, py::call_guard<py::gil_scoped_release>(), "Simulate a number of physics ticks, applying schedule[i] (an action per agent) before tick i. Graphics are updated and rendered once at the end (if render is set).")
+        .def("step_ticks", (bool (PySTKRace::*)(int, const std::vector<PySTKAction> &, bool)) &PySTKRace::stepTicks, py::arg("ticks"), py::arg("action") = std::vector<PySTKAction>(), py::arg("render") = true, py::call_guard<py::gil_scoped_release>(), "Simulate a number of physics ticks with a fixed action per agent. Graphics are updated and rendered once at the end (if render is set).")
         .def("stop", &PySTKRace::stop,"Stop the race")
+        .def("save_state", [](const PySTKRace & r) { return py::bytes(r.saveState()); }, "Save the simulation state of the running race (karts, items, projectiles, race clock) as an opaque blob. The blob is only valid for this race in this process.")
+        .def("load_state", [](PySTKRace & r, const py::bytes & state) { r.loadState(state); }, py::arg("state"), "Rewind the race to a state returned by save_state")
 #ifdef SERVER_ONLY
 .def_property_readonly("render_data", [](const PySTKRace &) -> py::list {return py::list();}, "rendering data from the last step")
 #else
@@ -196,6 +214,70 @@ PYBIND11_MODULE(pystk, m) {
         .def_property_readonly("config", &PySTKRace::config,"The current race configuration");
     }
     
+    {
+        py::class_<PySTKEpisodeRunner, std::shared_ptr<PySTKEpisodeRunner> >(m, "EpisodeRunner", "Runs a list of races to completion (or max_steps) in C++, without returning to python between steps. Records the observation, action and reward of all players at every step.")
+        .def(py::init<const std::vector<PySTKRaceConfig> &, int>(), py::arg("configs"), py::arg("max_steps"))
+        .def("run", [](const PySTKEpisodeRunner & r, py::object tapes, uintptr_t callback, uintptr_t user_data) {
+            const ssize_t E = r.numEpisodes(), T = r.maxSteps(), P = r.numPlayers();
+            py::array_t<float> observation({E, T, P, (ssize_t)PySTKEpisodeRunner::OBSERVATION_SIZE});
+            py::array_t<float> action({E, T, P, (ssize_t)PySTKEpisodeRunner::ACTION_SIZE});
+            py::array_t<float> reward({E, T, P});
+            py::array_t<int32_t> length(E);
+            PySTKEpisodeBuffer buffer;
+            buffer.observation = observation.mutable_data();
+            buffer.action = action.mutable_data();
+            buffer.reward = reward.mutable_data();
+            buffer.length = length.mutable_data();
+
+            PySTKEpisodePolicy policy;
+            std::vector<py::array_t<float, py::array::c_style | py::array::forcecast> > tape_arrays;
+            if (!tapes.is_none()) {
+                policy.type = PySTKEpisodePolicy::ACTION_TAPE;
+                for (py::handle t: tapes) {
+                    tape_arrays.push_back(py::cast<py::array_t<float, py::array::c_style | py::array::forcecast> >(t));
+                    const auto & a = tape_arrays.back();
+                    if (a.ndim() != 3 || a.shape(1) != P || a.shape(2) != PySTKEpisodeRunner::ACTION_SIZE)
+                        throw std::invalid_argument("Action tapes need the shape (steps, num_players, 7)");
+                    policy.tapes.push_back(a.data());
+                    policy.tape_lengths.push_back(a.shape(0));
+                }
+            } else if (callback) {
+                policy.type = PySTKEpisodePolicy::C_CALLBACK;
+                policy.callback = reinterpret_cast<PySTKPolicyCallback>(callback);
+                policy.user_data = reinterpret_cast<void *>(user_data);
+            }
+            {
+                py::gil_scoped_release release;
+                r.run(policy, buffer);
+            }
+            return py::dict("observation"_a=observation, "action"_a=action, "reward"_a=reward, "length"_a=length);
+        }, py::arg("tapes") = py::none(), py::arg("callback") = 0, py::arg("user_data") = 0,
+        "Run all episodes and return a dict of numpy arrays: observation (float E x max_steps x num_players x 16: location, rotation, front, velocity, speed, overall_distance, distance_down_track), action (float E x max_steps x num_players x 7: steering_angle, acceleration, brake, nitro, drift, rescue, fire), reward (float E x max_steps x num_players: overall distance gained in the step, 0 outside of linear races) and length (int32 E: number of valid steps per episode, the rest is zero). "
+        "The policy is the built-in AI for all players by default. tapes is a list of action arrays (float steps x num_players x 7) per episode, an episode stops at the end of its tape. "
+        "callback is the address of a C function void(int num_players, const float * observation, float * action, void * user_data) called every step, e.g. a ctypes.CFUNCTYPE. It is called without the GIL. "
+        "Graphics are not updated or rendered. No other race may be running.")
+        .def_property_readonly("configs", &PySTKEpisodeRunner::configs, "The race configuration of all episodes")
+        .def_property_readonly("num_players", &PySTKEpisodeRunner::numPlayers, "Number of players of each race")
+        .def_property_readonly("max_steps", &PySTKEpisodeRunner::maxSteps, "Maximum number of steps per episode");
+    }
+    
+    {
+        py::module pm = m.def_submodule("profiler", "Step-time profiler. Times the simulation (world, karts and AI, physics), rendering, readback and state extraction.");
+        pm.def("enable", [](bool trace, size_t max_trace_events) { profiler.enable(trace, max_trace_events); }, py::arg("trace") = false, py::arg("max_trace_events") = 1000000, "Start profiling. If trace is set, each event is recorded for trace() / write_trace() (up to max_trace_events).")
+        .def("disable", []() { profiler.disable(); }, "Stop profiling, the collected data is kept")
+        .def("is_enabled", []() { return profiler.isEnabled(); }, "Is the profiler enabled?")
+        .def("reset", []() { profiler.reset(); }, "Remove all collected data")
+        .def("stats", []() {
+            py::dict r;
+            for (const Profiler::MarkerStats & s: profiler.getStats())
+                r[py::str(s.m_name)] = py::dict("count"_a=s.m_count, "total"_a=s.m_total, "mean"_a=s.m_mean, "p50"_a=s.m_p50, "p99"_a=s.m_p99, "max"_a=s.m_max);
+            return r;
+        }, "Statistics per marker: count, total, mean, p50, p99 and max time (in ms)")
+        .def("trace", []() { return profiler.getTraceJSON(); }, "All recorded events in the Chrome trace event format (JSON)")
+        .def("write_trace", [](const std::string & filename) { profiler.writeTrace(filename); }, py::arg("filename"), "Write all recorded events in the Chrome trace event format, open in chrome://tracing or https://ui.perfetto.dev")
+        .def("dropped_trace_events", []() { return profiler.getDroppedTraceEvents(); }, "Number of events not recorded, since max_trace_events was reached");
+    }
+    
     m.def("list_tracks", &PySTKRace::listTracks, "Return a list of track names (possible values for RaceConfig.track)");
     m.def("list_karts", &PySTKRace::listKarts, "Return a list of karts to play as (possible values for PlayerConfig.kart");
     
@@ -203,6 +285,8 @@ PYBIND11_MODULE(pystk, m) {
     m.def("init", &path_and_init, py::arg("config"), "Initialize Python SuperTuxKart. Only call this function once per process. Calling it twice will cause a crash.");
     m.def("clean", &PySTKRace::clean, "Free Python SuperTuxKart, call this once at exit (optional). Will be called atexit otherwise.");
     
+    defineVectorRace(m);
+    
     auto atexit = py::module::import("atexit");
         atexit.attr("register")(py::cpp_function([]() {
             // A bit ugly
@@ -1,7 +1,7 @@
 #include "buffer.hpp"
 #include "graphics/gl_headers.hpp"
 #include "utils/log.hpp"
-#include "util.hpp"
+#include "utils/profiler.hpp"
 
 #ifndef SERVER_ONLY
 int n_channel(int format) {
@@ -41,6 +41,8 @@ BasicPBO::BasicPBO(int width, int height, int format, int type): width_(width),
     glBufferData(GL_PIXEL_PACK_BUFFER, size_, NULL, GL_STREAM_COPY);
 }
 BasicPBO::~BasicPBO() {
+    if (fence_)
+        glDeleteSync((GLsync)fence_);
     glDeleteBuffers(1, &buffer_id_);
 }
 void BasicPBO::read(GLuint texture) {
@@ -52,8 +54,24 @@ void BasicPBO::read(GLuint texture) {
         glGetTexImage(GL_TEXTURE_2D, 0, format_, type_, 0);
     }
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    // Track the completion of the transfer, so that we only stall once the data is needed
+    if (fence_)
+        glDeleteSync((GLsync)fence_);
+    fence_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+bool BasicPBO::ready() {
+    if (!fence_) return true;
+    GLenum r = glClientWaitSync((GLsync)fence_, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    return r == GL_ALREADY_SIGNALED || r == GL_CONDITION_SATISFIED;
+}
+void BasicPBO::wait() {
+    if (!fence_) return;
+    while (glClientWaitSync((GLsync)fence_, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED);
+    glDeleteSync((GLsync)fence_);
+    fence_ = nullptr;
 }
 void BasicPBO::write(void * mem) {
+    wait();
     glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer_id_);
     glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, size_, mem);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
@@ -61,6 +79,42 @@ void BasicPBO::write(void * mem) {
 
 
 
+FlippedTexture::FlippedTexture(int width, int height, int internal_format, int format, int type): width_(width), height_(height) {
+    if (format == GL_DEPTH_STENCIL || format == GL_DEPTH_COMPONENT) {
+        attachment_ = format == GL_DEPTH_STENCIL ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+        mask_ = GL_DEPTH_BUFFER_BIT;
+    } else {
+        attachment_ = GL_COLOR_ATTACHMENT0;
+        mask_ = GL_COLOR_BUFFER_BIT;
+    }
+    glGenTextures(1, &texture_);
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format, type, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(2, fbo_);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo_[1]);
+    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, attachment_, GL_TEXTURE_2D, texture_, 0);
+    glDrawBuffer(mask_ == GL_COLOR_BUFFER_BIT ? GL_COLOR_ATTACHMENT0 : GL_NONE);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+}
+FlippedTexture::~FlippedTexture() {
+    glDeleteFramebuffers(2, fbo_);
+    glDeleteTextures(1, &texture_);
+}
+unsigned int FlippedTexture::copy(unsigned int texture) {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo_[0]);
+    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, attachment_, GL_TEXTURE_2D, texture, 0);
+    glReadBuffer(mask_ == GL_COLOR_BUFFER_BIT ? GL_COLOR_ATTACHMENT0 : GL_NONE);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo_[1]);
+    glBlitFramebuffer(0, 0, width_, height_, 0, height_, width_, 0, mask_, GL_NEAREST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    return texture_;
+}
+
 py::array make(py::array::ShapeContainer shape, int gl_type) {
     switch(gl_type) {
         case GL_UNSIGNED_BYTE:  return py::array_t<unsigned char, py::array::c_style>(shape);
@@ -75,7 +129,7 @@ py::array make(py::array::ShapeContainer shape, int gl_type) {
     return py::array();
 }
 
-NumpyPBO::NumpyPBO(int width, int height, int format, int type): BasicPBO(width, height, format, type)
+NumpyPBO::NumpyPBO(int width, int height, int format, int type): BasicPBO(width, height, format, type), need_update_(false)
 {
     py::array::ShapeContainer shape = {height, width};
     int c = n_channel(format);
@@ -93,10 +147,16 @@ void NumpyPBO::read(unsigned int texture)
 py::array NumpyPBO::get()
 {
     if (need_update_) {
+        PROFILER_SCOPED_CPU_MARKER("PySTK::readback");
         // Copy data_ here to preveny any nasty surprises...
         data_ = make(py::array::ShapeContainer(data_.shape(), data_.shape() + data_.ndim()), type_);
-        BasicPBO::write(data_.mutable_data());
-        _yflip(data_.mutable_data(), data_.shape()[0], data_.strides()[0]);
+        void * mem = data_.mutable_data();
+        {
+            // Only the allocation above needs python, other threads may run while we wait for the GPU
+            py::gil_scoped_release release;
+            BasicPBO::write(mem);
+        }
+        need_update_ = false;
     }
     return data_;
 }
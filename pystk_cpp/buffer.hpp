@@ -7,15 +7,35 @@ class BasicPBO {
 protected:
     unsigned int buffer_id_;
     int width_, height_, format_, type_, size_;
+    void * fence_ = nullptr;
     BasicPBO(BasicPBO&) = delete;
     BasicPBO& operator=(BasicPBO&) = delete;
 public:
     BasicPBO(int width, int height, int format, int type);
     virtual void read(unsigned int texture);
     virtual void write(void * mem);
+    // Has the last read finished on the GPU? Never blocks.
+    bool ready();
+    // Block until the last read finished on the GPU.
+    void wait();
     virtual ~BasicPBO();
 };
 
+// Vertically flipped copy of a texture, produced on the GPU by a blit. This
+// turns OpenGL's bottom-up rows into the top-down layout numpy expects.
+class FlippedTexture {
+protected:
+    unsigned int texture_, fbo_[2];
+    int width_, height_, attachment_, mask_;
+    FlippedTexture(FlippedTexture&) = delete;
+    FlippedTexture& operator=(FlippedTexture&) = delete;
+public:
+    FlippedTexture(int width, int height, int internal_format, int format, int type);
+    // Flip texture into this object and return the texture id of the copy
+    unsigned int copy(unsigned int texture);
+    virtual ~FlippedTexture();
+};
+
 class NumpyPBO: public BasicPBO {
 protected:
     bool need_update_;
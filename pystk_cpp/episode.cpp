@@ -0,0 +1,149 @@
+#include "episode.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "config/stk_config.hpp"
+#include "karts/abstract_kart.hpp"
+#include "karts/controller/kart_control.hpp"
+#include "modes/linear_world.hpp"
+#include "modes/world.hpp"
+#include "utils/profiler.hpp"
+
+namespace {
+// Gives the runner access to the simulation without going through step(), which always updates the graphics
+class EpisodeRace: public PySTKRace {
+public:
+	using PySTKRace::PySTKRace;
+	using PySTKRace::setActions;
+	// Simulate one step of config().step_size without rendering, returns false once the race is over
+	bool advance() {
+		const float dt = config_.step_size;
+		time_leftover_ += dt;
+		int ticks = stk_config->time2Ticks(time_leftover_);
+		time_leftover_ -= stk_config->ticks2Time(ticks);
+		simulate(ticks);
+		return present(dt, false);
+	}
+};
+// Stops the race when the episode ends, also if start(), the policy or a step throws, so no world is left behind
+struct StopRace {
+	EpisodeRace & race;
+	~StopRace() { race.stop(); }
+};
+}
+
+static void put(float * o, const Vec3 & v) {
+	o[0] = v.getX(); o[1] = v.getY(); o[2] = v.getZ();
+}
+// Writes the observation of a player, and returns its overall distance
+static float observe(unsigned int player, float * o) {
+	World * w = World::getWorld();
+	LinearWorld * lw = dynamic_cast<LinearWorld*>(w);
+	const AbstractKart * k = w->getPlayerKart(player);
+	const unsigned int id = k->getWorldKartId();
+	const btQuaternion & q = k->getRotation();
+	put(o, k->getXYZ());
+	o[3] = q.x(); o[4] = q.y(); o[5] = q.z(); o[6] = q.w();
+	put(o+7, k->getFrontXYZ());
+	put(o+10, k->getVelocity());
+	o[13] = k->getSpeed();
+	o[14] = lw ? lw->getOverallDistance(id) : 0.f;
+	o[15] = lw ? lw->getDistanceDownTrackForKart(id, true) : 0.f;
+	return o[14];
+}
+static PySTKAction decodeAction(const float * a) {
+	PySTKAction r;
+	r.steering_angle = a[0];
+	r.acceleration = a[1];
+	r.brake = a[2] > 0.5f;
+	r.nitro = a[3] > 0.5f;
+	r.drift = a[4] > 0.5f;
+	r.rescue = a[5] > 0.5f;
+	r.fire = a[6] > 0.5f;
+	return r;
+}
+static void encodeAction(const PySTKAction & r, float * a) {
+	a[0] = r.steering_angle;
+	a[1] = r.acceleration;
+	a[2] = r.brake;
+	a[3] = r.nitro;
+	a[4] = r.drift;
+	a[5] = r.rescue;
+	a[6] = r.fire;
+}
+
+PySTKEpisodeRunner::PySTKEpisodeRunner(const std::vector<PySTKRaceConfig> & configs, int max_steps): configs_(configs), max_steps_(max_steps), num_players_(0) {
+	if (configs_.empty())
+		throw std::invalid_argument("EpisodeRunner needs at least one race config");
+	if (max_steps_ <= 0)
+		throw std::invalid_argument("EpisodeRunner needs max_steps > 0");
+	num_players_ = configs_[0].players.size();
+	for (const PySTKRaceConfig & c: configs_)
+		if (c.players.size() != (size_t)num_players_)
+			throw std::invalid_argument("All race configs of an EpisodeRunner need the same number of players");
+}
+void PySTKEpisodeRunner::run(const PySTKEpisodePolicy & policy, const PySTKEpisodeBuffer & buffer) const {
+	if (policy.type == PySTKEpisodePolicy::ACTION_TAPE && (policy.tapes.size() != configs_.size() || policy.tape_lengths.size() != configs_.size()))
+		throw std::invalid_argument("EpisodeRunner needs one action tape per race config");
+	if (policy.type == PySTKEpisodePolicy::C_CALLBACK && !policy.callback)
+		throw std::invalid_argument("EpisodeRunner needs a callback");
+	for (int i=0; i<numEpisodes(); i++)
+		runEpisode(i, policy, buffer);
+}
+void PySTKEpisodeRunner::runEpisode(int episode, const PySTKEpisodePolicy & policy, const PySTKEpisodeBuffer & buffer) const {
+	PROFILER_SCOPED_CPU_MARKER("EpisodeRunner::runEpisode");
+	PySTKRaceConfig config = configs_[episode];
+	if (policy.type == PySTKEpisodePolicy::BUILTIN_AI)
+		for (PySTKPlayerConfig & p: config.players)
+			p.controller = PySTKPlayerConfig::AI_CONTROL;
+
+	const size_t P = num_players_, O = P * OBSERVATION_SIZE, A = P * ACTION_SIZE;
+	float * observation = buffer.observation + (size_t)episode * max_steps_ * O;
+	float * action = buffer.action + (size_t)episode * max_steps_ * A;
+	float * reward = buffer.reward + (size_t)episode * max_steps_ * P;
+
+	EpisodeRace race(config);
+	StopRace stop_race{race};
+	race.start();
+	std::vector<PySTKAction> actions(P);
+	std::vector<float> distance(P);
+	int t = 0;
+	while (t < max_steps_) {
+		if (policy.type == PySTKEpisodePolicy::ACTION_TAPE && t >= policy.tape_lengths[episode])
+			break;
+		float * o = observation + t * O, * a = action + t * A, * r = reward + t * P;
+		for (size_t i=0; i<P; i++)
+			distance[i] = observe(i, o + i * OBSERVATION_SIZE);
+
+		if (policy.type == PySTKEpisodePolicy::ACTION_TAPE)
+			std::copy(policy.tapes[episode] + t * A, policy.tapes[episode] + (t + 1) * A, a);
+		else if (policy.type == PySTKEpisodePolicy::C_CALLBACK)
+			policy.callback(P, o, a, policy.user_data);
+		if (policy.type != PySTKEpisodePolicy::BUILTIN_AI) {
+			for (size_t i=0; i<P; i++)
+				actions[i] = decodeAction(a + i * ACTION_SIZE);
+			race.setActions(actions);
+		}
+
+		bool running = race.advance();
+		t++;
+
+		// The AI sets the controls of its kart during the step, record what it did
+		if (policy.type == PySTKEpisodePolicy::BUILTIN_AI)
+			for (size_t i=0; i<P; i++) {
+				actions[i].get(&World::getWorld()->getPlayerKart(i)->getControls());
+				encodeAction(actions[i], a + i * ACTION_SIZE);
+			}
+		LinearWorld * lw = dynamic_cast<LinearWorld*>(World::getWorld());
+		for (size_t i=0; i<P; i++)
+			r[i] = lw ? lw->getOverallDistance(World::getWorld()->getPlayerKart(i)->getWorldKartId()) - distance[i] : 0.f;
+		if (!running)
+			break;
+	}
+	// Clear the unused steps, so the buffer never holds data of a previous run
+	std::fill(observation + t * O, observation + max_steps_ * O, 0.f);
+	std::fill(action + t * A, action + max_steps_ * A, 0.f);
+	std::fill(reward + t * P, reward + max_steps_ * P, 0.f);
+	buffer.length[episode] = t;
+}
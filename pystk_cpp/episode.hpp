@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "pystk.hpp"
+
+// Called once per step with the observations of all players [num_players x OBSERVATION_SIZE], writes the actions
+// [num_players x ACTION_SIZE]. Runs without the GIL.
+typedef void (*PySTKPolicyCallback)(int num_players, const float * observation, float * action, void * user_data);
+
+struct PySTKEpisodePolicy {
+	enum Type: uint8_t {
+		BUILTIN_AI,
+		ACTION_TAPE,
+		C_CALLBACK,
+	};
+	Type type = BUILTIN_AI;
+	// ACTION_TAPE: one [length x num_players x ACTION_SIZE] action tape per episode
+	std::vector<const float *> tapes;
+	std::vector<int> tape_lengths;
+	// C_CALLBACK
+	PySTKPolicyCallback callback = nullptr;
+	void * user_data = nullptr;
+};
+
+// Preallocated output, all arrays are indexed [episode, step, player, ...]
+struct PySTKEpisodeBuffer {
+	float * observation = nullptr;
+	float * action = nullptr;
+	float * reward = nullptr;
+	int32_t * length = nullptr;
+};
+
+class PySTKEpisodeRunner {
+public:
+	enum {
+		// location (3), rotation (4), front (3), velocity (3), speed, overall_distance, distance_down_track
+		OBSERVATION_SIZE = 16,
+		// steering_angle, acceleration, brake, nitro, drift, rescue, fire
+		ACTION_SIZE = 7,
+	};
+
+protected:
+	std::vector<PySTKRaceConfig> configs_;
+	int max_steps_, num_players_;
+
+	void runEpisode(int episode, const PySTKEpisodePolicy & policy, const PySTKEpisodeBuffer & buffer) const;
+
+public:
+	PySTKEpisodeRunner(const std::vector<PySTKRaceConfig> & configs, int max_steps);
+	// Run all episodes one after the other, does not touch any python object
+	void run(const PySTKEpisodePolicy & policy, const PySTKEpisodeBuffer & buffer) const;
+	int numEpisodes() const { return configs_.size(); }
+	int numPlayers() const { return num_players_; }
+	int maxSteps() const { return max_steps_; }
+	const std::vector<PySTKRaceConfig> & configs() const { return configs_; }
+};
@@ -31,6 +31,13 @@ void pickle(std::ostream & s, const PySTKGraphicsConfig & o) {
     pickle(s, o.degraded_IBL);
     pickle(s, o.high_definition_textures);
     pickle(s, o.render);
+    pickle(s, o.readback_delay);
+    pickle(s, o.read_color);
+    pickle(s, o.read_depth);
+    pickle(s, o.read_instance);
+    pickle(s, o.track_cache_mb);
+    pickle(s, o.kart_threads);
+    pickle(s, o.physics_only);
 }
 void unpickle(std::istream & s, PySTKGraphicsConfig * o) {
     unpickle(s, &o->screen_width);
@@ -50,6 +57,13 @@ void unpickle(std::istream & s, PySTKGraphicsConfig * o) {
     unpickle(s, &o->degraded_IBL);
     unpickle(s, &o->high_definition_textures);
     unpickle(s, &o->render);
+    unpickle(s, &o->readback_delay);
+    unpickle(s, &o->read_color);
+    unpickle(s, &o->read_depth);
+    unpickle(s, &o->read_instance);
+    unpickle(s, &o->track_cache_mb);
+    unpickle(s, &o->kart_threads);
+    unpickle(s, &o->physics_only);
 }
 void pickle(std::ostream & s, const PySTKPlayerConfig & o) {
     pickle(s, o.kart);
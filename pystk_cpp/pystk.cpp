@@ -37,6 +37,8 @@
 #include <cstdio>
 #include <string>
 #include <cstring>
+#include <cstddef>
+#include <functional>
 #include <sstream>
 #include <algorithm>
 #include <limits>
@@ -74,9 +76,11 @@
 #include "karts/kart_properties_manager.hpp"
 #include "modes/world.hpp"
 #include "race/race_manager.hpp"
+#include "utils/snapshot.hpp"
 #include "scriptengine/property_animator.hpp"
 #include "tracks/arena_graph.hpp"
 #include "tracks/track.hpp"
+#include "tracks/track_cache.hpp"
 #include "tracks/track_manager.hpp"
 #include "utils/command_line.hpp"
 #include "utils/constants.hpp"
@@ -86,8 +90,8 @@
 #include "utils/mini_glm.hpp"
 #include "utils/profiler.hpp"
 #include "utils/string_utils.hpp"
+#include "utils/worker_pool.hpp"
 #include "utils/objecttype.h"
-#include "util.hpp"
 #include "buffer.hpp"
 
 #ifdef RENDERDOC
@@ -153,6 +157,11 @@ const PySTKGraphicsConfig & PySTKGraphicsConfig::none() {
                                          false, // degraded_IBL
                                          0,     // high_definition_textures
                                          false,   // render
+                                         0,     // readback_delay
+                                         true, true, true, // read_color, read_depth, read_instance
+                                         0,     // track_cache_mb
+                                         0,     // kart_threads
+                                         true,  // physics_only
     };
     return config;
 }
@@ -162,48 +171,81 @@ class PySTKRenderTarget {
     friend class PySTKRace;
 
 private:
-    const int BUF_SIZE = 2;
+    const int delay_, BUF_SIZE;
     std::unique_ptr<RenderTarget> rt_;
+    std::unique_ptr<FlippedTexture> color_flip_, depth_flip_, instance_flip_;
     std::vector<std::shared_ptr<NumpyPBO> > color_buf_, depth_buf_, instance_buf_;
-    int buf_num_=0;
+    int buf_num_=0, num_fetched_=0;
 
 protected:
-    void render(irr::scene::ICameraSceneNode* camera, float dt);
+    void render(irr::scene::ICameraSceneNode* camera, float dt, bool new_frame);
     void fetch(std::shared_ptr<PySTKRenderData> data);
+    void reset();
     
 public:
-    PySTKRenderTarget(std::unique_ptr<RenderTarget>&& rt);
+    PySTKRenderTarget(std::unique_ptr<RenderTarget>&& rt, const PySTKGraphicsConfig & config);
     
 };
 
-PySTKRenderTarget::PySTKRenderTarget(std::unique_ptr<RenderTarget>&& rt):rt_(std::move(rt)) {
+// The ring holds delay_+2 frames: the frame being read, delay_ frames in
+// flight and the frame currently handed out to python.
+// Only the buffers selected in the config are allocated and transferred.
+PySTKRenderTarget::PySTKRenderTarget(std::unique_ptr<RenderTarget>&& rt, const PySTKGraphicsConfig & config):delay_(std::max(config.readback_delay, 0)), BUF_SIZE(std::max(config.readback_delay, 0)+2), rt_(std::move(rt)) {
     int W = rt_->getTextureSize().Width, H = rt_->getTextureSize().Height;
     buf_num_ = 0;
+    if (config.read_color)
+        color_flip_.reset(new FlippedTexture(W, H, GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE));
+    if (config.read_depth)
+        depth_flip_.reset(new FlippedTexture(W, H, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8));
+    if (config.read_instance)
+        instance_flip_.reset(new FlippedTexture(W, H, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT));
     for(int i=0; i<BUF_SIZE; i++) {
-        color_buf_.push_back(std::make_shared<NumpyPBO>(W, H, GL_RGB, GL_UNSIGNED_BYTE));
-        depth_buf_.push_back(std::make_shared<NumpyPBO>(W, H, GL_DEPTH_COMPONENT, GL_FLOAT));
-        instance_buf_.push_back(std::make_shared<NumpyPBO>(W, H, GL_RED_INTEGER, GL_UNSIGNED_INT));
+        color_buf_.push_back(config.read_color ? std::make_shared<NumpyPBO>(W, H, GL_RGB, GL_UNSIGNED_BYTE) : nullptr);
+        depth_buf_.push_back(config.read_depth ? std::make_shared<NumpyPBO>(W, H, GL_DEPTH_COMPONENT, GL_FLOAT) : nullptr);
+        instance_buf_.push_back(config.read_instance ? std::make_shared<NumpyPBO>(W, H, GL_RED_INTEGER, GL_UNSIGNED_INT) : nullptr);
     }
 }
-void PySTKRenderTarget::render(irr::scene::ICameraSceneNode* camera, float dt) {
-    rt_->renderToTexture(camera, dt);
+void PySTKRenderTarget::render(irr::scene::ICameraSceneNode* camera, float dt, bool new_frame) {
+    PROFILER_PUSH_CPU_MARKER("PySTK::renderView", 0, 0, 0);
+    rt_->renderToTexture(camera, dt, new_frame);
+    PROFILER_POP_CPU_MARKER();
 }
 void PySTKRenderTarget::fetch(std::shared_ptr<PySTKRenderData> data) {
+    PROFILER_SCOPED_CPU_MARKER("PySTK::fetch (start readback)");
     RTT * rtts = rt_->getRTTs();
     if (rtts && data) {
-        unsigned int W = rtts->getWidth(), H = rtts->getHeight();
-        // Read the color and depth image
-        data->color_buf_ = color_buf_[buf_num_];
-        data->depth_buf_ = depth_buf_[buf_num_];
-        data->instance_buf_ = instance_buf_[buf_num_];
-        
-        data->depth_buf_->read(rtts->getDepthStencilTexture());
-        data->color_buf_->read(rtts->getRenderTarget(RTT_COLOR));
-        data->instance_buf_->read(rtts->getRenderTarget(RTT_LABEL));
+        // Flip the images on the GPU and start reading them
+        if (depth_flip_)
+            depth_buf_[buf_num_]->read(depth_flip_->copy(rtts->getDepthStencilTexture()));
+        if (color_flip_)
+            color_buf_[buf_num_]->read(color_flip_->copy(rtts->getRenderTarget(RTT_COLOR)));
+        if (instance_flip_)
+            instance_buf_[buf_num_]->read(instance_flip_->copy(rtts->getRenderTarget(RTT_LABEL)));
+
+        // Hand out the frame from delay_ steps ago (or the oldest one we have)
+        int slot = (buf_num_ + BUF_SIZE - std::min(delay_, num_fetched_)) % BUF_SIZE;
+        data->color_buf_ = color_buf_[slot];
+        data->depth_buf_ = depth_buf_[slot];
+        data->instance_buf_ = instance_buf_[slot];
         buf_num_ = (buf_num_+1) % BUF_SIZE;
+        num_fetched_++;
     }
     
 }
+// Drops the frames in flight, the next fetch hands out the frame it reads
+void PySTKRenderTarget::reset() {
+    buf_num_ = 0;
+    num_fetched_ = 0;
+}
+bool PySTKRenderData::ready() const {
+    return (!color_buf_ || color_buf_->ready()) && (!depth_buf_ || depth_buf_->ready()) && (!instance_buf_ || instance_buf_->ready());
+}
+void PySTKRenderData::wait() const {
+    PROFILER_SCOPED_CPU_MARKER("PySTK::wait (readback)");
+    if (color_buf_) color_buf_->wait();
+    if (depth_buf_) depth_buf_->wait();
+    if (instance_buf_) instance_buf_->wait();
+}
 #endif  // SERVER_ONLY
 
 void PySTKAction::set(KartControl * control) const {
@@ -234,6 +276,8 @@ static RENDERDOC_API_1_1_2 *rdoc_api = NULL;
 void PySTKRace::init(const PySTKGraphicsConfig & config, const std::string & data_dir) {
     if (running_kart)
         throw std::invalid_argument("Cannot init while supertuxkart is running!");
+    if (config.physics_only && config.render)
+        throw std::invalid_argument("GraphicsConfig.physics_only requires render=False");
     if (is_init) {
         throw std::invalid_argument("PySTK already initialized! Call clean first!");
     } else {
@@ -243,6 +287,10 @@ void PySTKRace::init(const PySTKGraphicsConfig & config, const std::string & dat
         stk_config->load(file_manager->getAsset("stk_config.xml"));
         initGraphicsConfig(config);
         initRest();
+        if (config.track_cache_mb > 0)
+            TrackCache::create((size_t)config.track_cache_mb << 20);
+        if (config.kart_threads > 1)
+            WorkerPool::create(config.kart_threads);
         load();
     }
 #ifdef RENDERDOC
@@ -292,7 +340,7 @@ PySTKRace::PySTKRace(const PySTKRaceConfig & config) {
 #ifndef SERVER_ONLY
     if (graphics_config_.render)
         for(int i=0; i<config.players.size(); i++)
-            render_targets_.push_back( std::make_unique<PySTKRenderTarget>(irr_driver->createRenderTarget( {(unsigned int)UserConfigParams::m_width, (unsigned int)UserConfigParams::m_height}, "player"+std::to_string(i))) );
+            render_targets_.push_back( std::make_unique<PySTKRenderTarget>(irr_driver->createRenderTarget( {(unsigned int)UserConfigParams::m_width, (unsigned int)UserConfigParams::m_height}, "player"+std::to_string(i)), graphics_config_) );
 #endif  // SERVER_ONLY
 }
 std::vector<std::string> PySTKRace::listTracks() {
@@ -321,6 +369,10 @@ public:
     { ai_controller_->reset(); }
     virtual void  update             (int ticks)
     { ai_controller_->update(ticks); }
+    virtual void  saveState          (Snapshot *s) const
+    { ai_controller_->saveState(s); }
+    virtual void  restoreState       (Snapshot *s)
+    { ai_controller_->restoreState(s); }
     virtual void  handleZipper       ()
     { ai_controller_->handleZipper(); }
     virtual void  collectedItem      (const ItemState &item,
@@ -362,22 +414,80 @@ public:
 };
 void PySTKRace::restart() {
     World::getWorld()->reset(true /* restart */);
-    ItemManager::updateRandomSeed(config_.seed);
-    powerup_manager->setRandomSeed(config_.seed);
+#ifndef SERVER_ONLY
+    // Frames rendered before the restart must not be handed out after it
+    for (auto & rt: render_targets_)
+        rt->reset();
+#endif  // SERVER_ONLY
 }
 
 void PySTKRace::start() {
     race_manager->setupPlayerKartInfo();
     race_manager->startNew();
     time_leftover_ = 0.f;
+    // Every start is a new race, states of the previous one can't be loaded
+    static uint32_t num_races = 0;
+    race_id_ = ++num_races;
     
     for(int i=0; i<config_.players.size(); i++) {
         AbstractKart * player_kart = World::getWorld()->getPlayerKart(i);
         if (config_.players[i].controller == PySTKPlayerConfig::AI_CONTROL)
             player_kart->setController(new LocalPlayerAIController(World::getWorld()->loadAIController(player_kart)));
     }
-    ItemManager::updateRandomSeed(config_.seed);
-    powerup_manager->setRandomSeed(config_.seed);
+}
+// Identifies the race a state was saved from, checked before anything is restored
+struct PySTKStateHeader {
+    uint32_t magic;
+    uint32_t race_id;
+    uint64_t track_hash;
+    uint32_t num_karts;
+    uint64_t size;
+};
+static const uint32_t STATE_MAGIC = 0x54534b53; // "SKST"
+static PySTKStateHeader stateHeader(uint32_t race_id) {
+    PySTKStateHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = STATE_MAGIC;
+    h.race_id = race_id;
+    h.track_hash = std::hash<std::string>()(Track::getCurrentTrack()->getIdent());
+    h.num_karts = World::getWorld()->getNumKarts();
+    return h;
+}
+std::string PySTKRace::saveState() const {
+    if (!World::getWorld())
+        throw std::invalid_argument("Cannot save the state of a race that is not running");
+    Snapshot s;
+    s.add(stateHeader(race_id_));
+    s.add(time_leftover_);
+    World::getWorld()->saveState(&s);
+    std::string data = s.getData();
+    // Patch in the total size, so that truncated states are rejected
+    uint64_t size = data.size();
+    memcpy(&data[offsetof(PySTKStateHeader, size)], &size, sizeof(size));
+    return data;
+}
+void PySTKRace::loadState(const std::string & state) {
+    if (!World::getWorld())
+        throw std::invalid_argument("Cannot load the state of a race that is not running");
+    PySTKStateHeader expected = stateHeader(race_id_), header;
+    if (state.size() < sizeof(header))
+        throw std::invalid_argument("Not a race state");
+    memcpy(&header, state.data(), sizeof(header));
+    if (header.magic != STATE_MAGIC || header.size != state.size())
+        throw std::invalid_argument("Not a race state");
+    if (header.race_id != expected.race_id || header.track_hash != expected.track_hash || header.num_karts != expected.num_karts)
+        throw std::invalid_argument("State was saved by a different race");
+    Snapshot s(state);
+    s.get<PySTKStateHeader>();
+    s.get(&time_leftover_);
+    World::getWorld()->restoreState(&s);
+    if (!s.isEnd())
+        throw std::invalid_argument("State was saved by a different race");
+#ifndef SERVER_ONLY
+    // Frames rendered before the load must not be handed out after it
+    for (auto & rt: render_targets_)
+        rt->reset();
+#endif  // SERVER_ONLY
 }
 void PySTKRace::stop() {
 #ifndef SERVER_ONLY
@@ -389,57 +499,87 @@ void PySTKRace::stop() {
     }
 }
 void PySTKRace::render(float dt) {
+    PROFILER_SCOPED_CPU_MARKER("PySTKRace::render");
     World *world = World::getWorld();
 #ifndef SERVER_ONLY
     if (world && graphics_config_.render)
     {
-        // Render all views
+        while (render_data_.size() < render_targets_.size()) render_data_.push_back( std::make_shared<PySTKRenderData>() );
+        // Render all views, the scene is animated and the lighting uploaded once for all of them.
+        // All views share their RTTs, so each view is fetched before the next one overwrites it.
         for(unsigned int i = 0; i < Camera::getNumCameras() && i < render_targets_.size(); i++) {
             Camera::getCamera(i)->activate(false);
-            render_targets_[i]->render(Camera::getCamera(i)->getCameraSceneNode(), dt);
-        }
-        while (render_data_.size() < render_targets_.size()) render_data_.push_back( std::make_shared<PySTKRenderData>() );
-        // Fetch all views
-        for(unsigned int i = 0; i < render_targets_.size(); i++) {
+            render_targets_[i]->render(Camera::getCamera(i)->getCameraSceneNode(), dt, i == 0);
             render_targets_[i]->fetch(render_data_[i]);
         }
     }
 #endif  // SERVER_ONLY
 }
 
-bool PySTKRace::step(const std::vector<PySTKAction> & a) {
+void PySTKRace::setActions(const std::vector<PySTKAction> & a) {
     for(int i=0; i<a.size(); i++) {
         KartControl & control = World::getWorld()->getPlayerKart(i)->getControls();
         a[i].set(&control);
     }
-    return step();
 }
-bool PySTKRace::step(const PySTKAction & a) {
+bool PySTKRace::step(const std::vector<PySTKAction> & a, int frame_skip) {
+    if (!World::getWorld()) return false;
+    setActions(a);
+    return step(frame_skip);
+}
+bool PySTKRace::step(const PySTKAction & a, int frame_skip) {
+    if (!World::getWorld()) return false;
     KartControl & control = World::getWorld()->getPlayerKart(0)->getControls();
     a.set(&control);
-    return step();
+    return step(frame_skip);
 }
-bool PySTKRace::step() {
-    const float dt = config_.step_size;
+bool PySTKRace::step(int frame_skip) {
+    PROFILER_SCOPED_CPU_MARKER("PySTKRace::step");
+    const float dt = std::max(frame_skip, 1) * config_.step_size;
     if (!World::getWorld()) return false;
-    
-#ifdef RENDERDOC
-    if(rdoc_api) rdoc_api->StartFrameCapture(NULL, NULL);
-#endif
 
-    // Update first
     time_leftover_ += dt;
     int ticks = stk_config->time2Ticks(time_leftover_);
     time_leftover_ -= stk_config->ticks2Time(ticks);
+    simulate(ticks);
+    return present(dt, true);
+}
+bool PySTKRace::stepTicks(int ticks, const std::vector<std::vector<PySTKAction> > & schedule, bool render) {
+    PROFILER_SCOPED_CPU_MARKER("PySTKRace::step");
+    if (!World::getWorld()) return false;
+    simulate(ticks, &schedule);
+    return present(stk_config->ticks2Time(ticks), render);
+}
+bool PySTKRace::stepTicks(int ticks, const std::vector<PySTKAction> & a, bool render) {
+    PROFILER_SCOPED_CPU_MARKER("PySTKRace::step");
+    if (!World::getWorld()) return false;
+    setActions(a);
+    simulate(ticks);
+    return present(stk_config->ticks2Time(ticks), render);
+}
+bool PySTKRace::isRaceRunning() const {
+    return race_manager && race_manager->getFinishedPlayers() < race_manager->getNumPlayers();
+}
+void PySTKRace::simulate(int ticks, const std::vector<std::vector<PySTKAction> > * schedule) {
+    PROFILER_PUSH_CPU_MARKER("PySTKRace::simulate", 0, 0, 0);
     for(int i=0; i<ticks; i++) {
+        if (schedule && i < schedule->size())
+            setActions((*schedule)[i]);
         World::getWorld()->updateWorld(1);
         World::getWorld()->updateTime(1);
     }
-    
+    PROFILER_POP_CPU_MARKER();
+}
+bool PySTKRace::present(float dt, bool do_render) {
+    PROFILER_SCOPED_CPU_MARKER("PySTKRace::present");
+#ifdef RENDERDOC
+    if(rdoc_api) rdoc_api->StartFrameCapture(NULL, NULL);
+#endif
+
     PropertyAnimator::get()->update(dt);
     
     // Then render
-    if (graphics_config_.render) {
+    if (graphics_config_.render && do_render) {
         World::getWorld()->updateGraphics(dt);
 
         irr_driver->minimalUpdate(dt);
@@ -453,7 +593,7 @@ bool PySTKRace::step() {
 #ifdef RENDERDOC
     if(rdoc_api) rdoc_api->EndFrameCapture(NULL, NULL);
 #endif
-    return race_manager && race_manager->getFinishedPlayers() < race_manager->getNumPlayers();
+    return isRaceRunning();
 }
 
 void PySTKRace::load() {
@@ -482,9 +622,15 @@ void PySTKRace::load() {
         material_manager->addSharedMaterial(materials_file);
     }
     Referee::init();
-    powerup_manager->loadPowerupsModels();
-    ItemManager::loadDefaultItemMeshes();
-    attachment_manager->loadModels();
+    {
+#ifndef SERVER_ONLY
+        // Decode the textures of all models together
+        SP::SPTextureManager::ScopedBatch texture_batch;
+#endif
+        powerup_manager->loadPowerupsModels();
+        ItemManager::loadDefaultItemMeshes();
+        attachment_manager->loadModels();
+    }
     file_manager->popTextureSearchPath();
 }
 
@@ -522,6 +668,7 @@ void PySTKRace::setupConfig(const PySTKRaceConfig & config) {
         race_manager->setTrack("lighthouse");
     
     race_manager->setNumLaps(config.laps);
+    race_manager->setRandomSeed(config.seed);
     race_manager->setNumKarts(config.num_kart);
     race_manager->setMaxGoal(1<<30);
 }
@@ -543,6 +690,8 @@ void PySTKRace::initGraphicsConfig(const PySTKGraphicsConfig & config) {
     UserConfigParams::m_ssao = config.ssao;
     UserConfigParams::m_degraded_IBL = config.degraded_IBL;
     UserConfigParams::m_high_definition_textures = config.high_definition_textures;
+    // Skips all GPU uploads, only allowed if rendering is disabled (see init)
+    UserConfigParams::m_physics_only = config.physics_only;
 }
 
 
@@ -578,7 +727,9 @@ void PySTKRace::initRest()
     irr_driver->initDevice();
 
     font_manager = new FontManager();
-    font_manager->loadFonts();
+    // Fonts are only used by text billboards, which are never drawn in physics only mode
+    if (!UserConfigParams::m_physics_only)
+        font_manager->loadFonts();
     SP::loadShaders();
 
     // The order here can be important, e.g. KartPropertiesManager needs
@@ -637,6 +788,8 @@ void PySTKRace::cleanSuperTuxKart()
     projectile_manager = nullptr;
     if(kart_properties_manager) delete kart_properties_manager;
     kart_properties_manager = nullptr;
+    TrackCache::destroy();
+    WorkerPool::destroy();
     if(track_manager)           delete track_manager;
     track_manager = nullptr;
     if(material_manager)        delete material_manager;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include "buffer.hpp"
@@ -16,6 +17,11 @@ struct PySTKGraphicsConfig {
 	bool degraded_IBL = false;
 	int high_definition_textures = 2 | 1;
 	bool render = true;
+	int readback_delay = 0;
+	bool read_color = true, read_depth = true, read_instance = true;
+	int track_cache_mb = 0;
+	int kart_threads = 0;
+	bool physics_only = false;
 	
 	static const PySTKGraphicsConfig & hd();
 	static const PySTKGraphicsConfig & sd();
@@ -58,6 +64,8 @@ class PySTKRenderTarget;
 #ifndef SERVER_ONLY
 struct PySTKRenderData {
     std::shared_ptr<NumpyPBO> color_buf_, depth_buf_, instance_buf_;
+    bool ready() const;
+    void wait() const;
 };
 #endif  // SERVER_ONLY
 
@@ -96,6 +104,12 @@ public: // Static methods
 protected:
 	void setupConfig(const PySTKRaceConfig & config);
 	void setupRaceStart();
+	void setActions(const std::vector<PySTKAction> &);
+	bool isRaceRunning() const;
+	// Advance the simulation without any graphics, schedule[i] is applied before tick i
+	void simulate(int ticks, const std::vector<std::vector<PySTKAction> > * schedule = nullptr);
+	// Update the graphics state by dt and (optionally) render and read back all views
+	bool present(float dt, bool do_render);
 	void render(float dt);
 #ifndef SERVER_ONLY
 	std::vector<std::unique_ptr<PySTKRenderTarget> > render_targets_;
@@ -103,6 +117,7 @@ protected:
 #endif  // SERVER_ONLY
 	PySTKRaceConfig config_;
 	float time_leftover_ = 0;
+	uint32_t race_id_ = 0;
 
 public:
 	PySTKRace(const PySTKRace &) = delete;
@@ -111,10 +126,14 @@ public:
 	~PySTKRace();
 	void restart();
 	void start();
-	bool step(const std::vector<PySTKAction> &);
-	bool step(const PySTKAction &);
-	bool step();
+	bool step(const std::vector<PySTKAction> &, int frame_skip = 1);
+	bool step(const PySTKAction &, int frame_skip = 1);
+	bool step(int frame_skip = 1);
+	bool stepTicks(int ticks, const std::vector<std::vector<PySTKAction> > & schedule, bool render = true);
+	bool stepTicks(int ticks, const std::vector<PySTKAction> & action, bool render = true);
 	void stop();
+	std::string saveState() const;
+	void loadState(const std::string & state);
 #ifndef SERVER_ONLY
 	const std::vector<std::shared_ptr<PySTKRenderData> > & render_data() const { return render_data_; }
 #endif  // SERVER_ONLY
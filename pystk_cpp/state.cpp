@@ -11,11 +11,13 @@
 #include "karts/controller/local_player_controller.hpp"
 #include "karts/kart_properties.hpp"
 #include "items/attachment.hpp"
+#include "items/flyable.hpp"
 #include "items/item.hpp"
 #include "items/item_manager.hpp"
 #include "items/powerup.hpp"
 #include "items/powerup_manager.hpp"
 #include "items/powerup_manager.hpp"
+#include "items/projectile_manager.hpp"
 #include "modes/world.hpp"
 #include "modes/linear_world.hpp"
 #include "modes/soccer_world.hpp"
@@ -24,6 +26,7 @@
 #include "tracks/drive_graph.hpp"
 #include "tracks/drive_node.hpp"
 #include "tracks/track.hpp"
+#include "utils/profiler.hpp"
 #include "utils/vec3.hpp"
 #include "view.hpp"
 #include "pickle.hpp"
@@ -542,6 +545,139 @@ struct PyTrack {
 	}
 };
 
+namespace {
+// Contiguous (structure of arrays) version of the world state. All buffers
+// are allocated once and overwritten in place by update(), they are only
+// reallocated if the number of karts, items or projectiles changes.
+struct PyWorldArrays {
+	py::array_t<int32_t> kart_id, kart_player_id, kart_finished_laps, kart_lives, kart_powerup_num;
+	py::array_t<float> kart_location, kart_rotation, kart_front, kart_velocity;
+	py::array_t<float> kart_overall_distance, kart_distance_down_track, kart_finish_time, kart_attachment_time;
+	py::array_t<uint8_t> kart_jumping, kart_powerup, kart_attachment;
+	py::array_t<int32_t> item_id;
+	py::array_t<float> item_location, item_size;
+	py::array_t<uint8_t> item_type;
+	py::array_t<int32_t> projectile_id;
+	py::array_t<float> projectile_location, projectile_velocity;
+	py::array_t<uint8_t> projectile_type;
+	float time = 0;
+	std::vector<const Item*> valid_items_;
+
+	template<typename T>
+	static T * reserve(py::array_t<T> & a, ssize_t n, ssize_t c = 0) {
+		if (a.ndim() != (c ? 2 : 1) || a.shape(0) != n || (c && a.shape(1) != c))
+			a = c ? py::array_t<T>(py::array::ShapeContainer({n, c})) : py::array_t<T>(n);
+		return a.mutable_data();
+	}
+	static void define(py::object m) {
+		py::class_<PyWorldArrays, std::shared_ptr<PyWorldArrays>> c(m, "WorldArrays", "World state as contiguous numpy arrays. update() overwrites all arrays in place, copy them if they need to outlive the next update.");
+		c.def(py::init<>())
+#define R(x, d) .def_readonly(#x, &PyWorldArrays::x, d)
+		  R(kart_id, "Kart id compatible with instance labels (int32 N)")
+		  R(kart_player_id, "Player id or -1 for non-player karts (int32 N)")
+		  R(kart_location, "3D world location of the karts (float N x 3)")
+		  R(kart_rotation, "Quaternion rotation of the karts (float N x 4)")
+		  R(kart_front, "Front direction of karts (float N x 3)")
+		  R(kart_velocity, "Velocity of karts (float N x 3)")
+		  R(kart_overall_distance, "Overall distance traveled (float N)")
+		  R(kart_distance_down_track, "Distance traveled on current lap (float N)")
+		  R(kart_finished_laps, "Number of laps completed (int32 N)")
+		  R(kart_finish_time, "Time to complete race (float N)")
+		  R(kart_lives, "Lives in three strikes battle (int32 N)")
+		  R(kart_jumping, "Is the kart jumping? (uint8 N)")
+		  R(kart_powerup, "Powerup.Type collected (uint8 N)")
+		  R(kart_powerup_num, "Number of powerups (int32 N)")
+		  R(kart_attachment, "Attachment.Type of kart (uint8 N)")
+		  R(kart_attachment_time, "Seconds until attachment detaches/explodes (float N)")
+		  R(item_id, "Item id compatible with instance data (int32 M)")
+		  R(item_location, "3D world location of the items (float M x 3)")
+		  R(item_size, "Size of the items (float M)")
+		  R(item_type, "Item.Type (uint8 M)")
+		  R(projectile_id, "Projectile id compatible with instance data (int32 P)")
+		  R(projectile_location, "3D world location of projectiles (float P x 3)")
+		  R(projectile_velocity, "Velocity of projectiles (float P x 3)")
+		  R(projectile_type, "Powerup.Type that fired the projectile (uint8 P)")
+		  R(time, "Game time")
+#undef R
+		 .def("update", &PyWorldArrays::update, "Update all arrays with the current world state")
+		 .def("__repr__", [](const PyWorldArrays &a) { return "<WorldArrays #karts="+std::to_string(a.kart_id.size())+" #items="+std::to_string(a.item_id.size())+">"; });
+	}
+	static void put(float * o, const Vec3 & v) {
+		o[0] = v.getX(); o[1] = v.getY(); o[2] = v.getZ();
+	}
+	void update() {
+		PROFILER_SCOPED_CPU_MARKER("WorldArrays::update");
+		World * w = World::getWorld();
+		LinearWorld * lw = dynamic_cast<LinearWorld*>(w);
+		ThreeStrikesBattle * tw = dynamic_cast<ThreeStrikesBattle*>(w);
+		// Without a world (e.g. after race.stop()) there are no karts, don't keep those of the last race
+		const ssize_t N = w ? w->getKarts().size() : 0;
+		int32_t * id = reserve(kart_id, N), * pid = reserve(kart_player_id, N);
+		int32_t * laps = reserve(kart_finished_laps, N), * lives = reserve(kart_lives, N), * pnum = reserve(kart_powerup_num, N);
+		float * loc = reserve(kart_location, N, 3), * rot = reserve(kart_rotation, N, 4);
+		float * front = reserve(kart_front, N, 3), * vel = reserve(kart_velocity, N, 3);
+		float * dist = reserve(kart_overall_distance, N), * ddt = reserve(kart_distance_down_track, N);
+		float * ft = reserve(kart_finish_time, N), * at = reserve(kart_attachment_time, N);
+		uint8_t * jump = reserve(kart_jumping, N), * pu = reserve(kart_powerup, N), * att = reserve(kart_attachment, N);
+		int player = 0;
+		for(ssize_t i=0; i<N; i++) {
+			const AbstractKart * K = w->getKarts()[i].get();
+			id[i] = K->getWorldKartId();
+			pid[i] = K->getController()->isLocalPlayerController() ? player++ : -1;
+			put(loc+3*i, K->getXYZ());
+			const btQuaternion & q = K->getRotation();
+			rot[4*i+0] = q.x(); rot[4*i+1] = q.y(); rot[4*i+2] = q.z(); rot[4*i+3] = q.w();
+			put(front+3*i, K->getFrontXYZ());
+			put(vel+3*i, K->getVelocity());
+			jump[i] = K->isJumping();
+			ft[i] = K->getFinishTime();
+			const Powerup * p = K->getPowerup();
+			pu[i] = p ? p->getType() : PowerupManager::POWERUP_NOTHING;
+			pnum[i] = p ? p->getNum() : 0;
+			const Attachment * a = K->getAttachment();
+			att[i] = a ? a->getType() : Attachment::ATTACH_NOTHING;
+			at[i] = a ? stk_config->ticks2Time(a->getTicksLeft()) : 0.f;
+			laps[i] = lw ? lw->getFinishedLapsOfKart(i) : 0;
+			dist[i] = lw ? lw->getOverallDistance(i) : 0.f;
+			ddt[i] = lw ? lw->getDistanceDownTrackForKart(i, true) : 0.f;
+			lives[i] = tw ? tw->getKartLife(i) : 0;
+		}
+		time = w ? w->getTime() : 0.f;
+		ItemManager * im = ItemManager::get();
+		valid_items_.clear();
+		if (im) {
+			for(unsigned int i=0; i<im->getNumberOfItems(); i++) {
+				const Item * I = dynamic_cast<const Item*>(im->getItem(i));
+				if (PyItem::isValid(I))
+					valid_items_.push_back(I);
+			}
+		}
+		const ssize_t M = valid_items_.size();
+		int32_t * iid = reserve(item_id, M);
+		float * iloc = reserve(item_location, M, 3), * isz = reserve(item_size, M);
+		uint8_t * ity = reserve(item_type, M);
+		for(ssize_t i=0; i<M; i++) {
+			const Item * I = valid_items_[i];
+			iid[i] = I->getObjectId();
+			put(iloc+3*i, I->getXYZ());
+			isz[i] = I->getAvoidancePoint(0) ? (I->getXYZ() - *I->getAvoidancePoint(0)).length() : 1.1f;
+			ity[i] = I->getType();
+		}
+		const ssize_t P = projectile_manager ? projectile_manager->getActiveProjectiles().size() : 0;
+		int32_t * prid = reserve(projectile_id, P);
+		float * ploc = reserve(projectile_location, P, 3), * pvel = reserve(projectile_velocity, P, 3);
+		uint8_t * pty = reserve(projectile_type, P);
+		for(ssize_t i=0; i<P; i++) {
+			const Flyable * f = projectile_manager->getActiveProjectiles()[i].get();
+			prid[i] = f->getObjectId();
+			put(ploc+3*i, f->getXYZ());
+			put(pvel+3*i, f->getVelocity());
+			pty[i] = f->getType();
+		}
+	}
+};
+}
+
 struct PyWorldState {
 	std::vector<std::shared_ptr<PyPlayer> > players;
 	std::vector<std::shared_ptr<PyKart> > karts;
@@ -562,6 +698,8 @@ struct PyWorldState {
 		  R(ffa, "Free for all match info")
 #undef R
 		 .def("update", &PyWorldState::update, "Update this object with the current world state")
+		 .def_static("as_arrays", []() { auto r = std::make_shared<PyWorldArrays>(); r->update(); return r; }, "Return the current world state as contiguous numpy arrays (WorldArrays)")
+		 .def_static("update_into", [](PyWorldArrays & a) { a.update(); }, py::arg("arrays"), "Write the current world state into preallocated WorldArrays")
 		 .def("__repr__", [](const PyWorldState &k) { return "<WorldState #karts="+std::to_string(k.karts.size())+">"; })
 		 .def_static("set_ball_location", &PyWorldState::set_ball_location, py::arg("position"), py::arg("velocity")=PyVec3{0,0,0}, py::arg("angular_velocity")=PyVec3{0,0,0}, "Specify the soccer ball / hockey puck position (SOCCER mode only).")
 		 .def_static("set_kart_location", &PyWorldState::set_kart_location, py::arg("kart_id"), py::arg("position"), py::arg("rotation")=PyQuaternion{0,0,0,1}, py::arg("speed")=0, "Move a kart to a specific location.");
@@ -574,6 +712,7 @@ struct PyWorldState {
 				players[k->player_id]->kart = k;
 	}
 	void update() {
+		PROFILER_SCOPED_CPU_MARKER("WorldState::update");
 		World * w = World::getWorld();
 		LinearWorld * lw = dynamic_cast<LinearWorld*>(w);
 		SoccerWorld * sw = dynamic_cast<SoccerWorld*>(w);
@@ -820,6 +959,7 @@ void defineState(py::object m) {
 	PySoccerBall::define(m);
 	PySoccer::define(m);
 	PyFFA::define(m);
+	PyWorldArrays::define(m);
 	PyWorldState::define(m);
 	PyTrack::define(m);
 };
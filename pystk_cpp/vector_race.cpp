@@ -0,0 +1,137 @@
+#include "vector_race.hpp"
+
+#include <pybind11/eval.h>
+
+namespace py = pybind11;
+
+namespace {
+// The functions are looked up as pystk.<name> when a worker is spawned, so they have to be module attributes
+const char * VECTOR_RACE_SOURCE = R"py(
+def _vector_race_observe(race, state):
+    """Default observation of a VectorRace worker: location, velocity and distance_down_track of each player's kart
+    (float32 num_players x 3, num_players x 3 and num_players), and the image of each player if rendering"""
+    import numpy as np
+    karts = [p.kart for p in state.players]
+    obs = {'location': np.array([k.location for k in karts], dtype=np.float32),
+           'velocity': np.array([k.velocity for k in karts], dtype=np.float32),
+           'distance_down_track': np.array([k.distance_down_track for k in karts], dtype=np.float32)}
+    if len(race.render_data):
+        obs['image'] = np.stack([np.array(r.image) for r in race.render_data])
+    return obs
+
+
+def _vector_race_worker(pipe, graphics_config, race_config, observe):
+    import pystk
+    pystk.init(graphics_config)
+    race = pystk.Race(race_config)
+    state = pystk.WorldState()
+
+    def reply(running):
+        state.update()
+        obs = observe(race, state)
+        obs['running'] = running
+        pipe.send(obs)
+
+    try:
+        race.start()
+        reply(True)
+        while True:
+            cmd, data = pipe.recv()
+            if cmd == 'step':
+                reply(race.step(data))
+            elif cmd == 'restart':
+                race.restart()
+                reply(True)
+            else:
+                break
+    finally:
+        race.stop()
+        del race
+        pystk.clean()
+        pipe.close()
+
+
+class VectorRace:
+    """Runs several independent races, one per worker process, and steps them in lock-step. step() sends all actions
+    before it waits for any observation, so N races keep up to N cores busy. Observations are dicts of numpy arrays
+    stacked over the races."""
+
+    def __init__(self, race_configs, graphics_config=None, observe=None):
+        """Start one worker per race config. graphics_config defaults to GraphicsConfig.none(). observe(race, state)
+        returns the observation of a worker as a dict of numpy arrays, it runs in the worker and thus has to be a
+        module level function. The default returns location, velocity and distance_down_track of the player karts
+        and their images if rendering. A bool 'running' is added to every observation."""
+        import multiprocessing as mp
+        import pystk
+        if graphics_config is None:
+            graphics_config = pystk.GraphicsConfig.none()
+        if observe is None:
+            observe = _vector_race_observe
+        ctx = mp.get_context('spawn')
+        self._pipes, self._procs = [], []
+        for c in race_configs:
+            parent, child = ctx.Pipe()
+            p = ctx.Process(target=_vector_race_worker, args=(child, graphics_config, c, observe), daemon=True)
+            p.start()
+            child.close()
+            self._pipes.append(parent)
+            self._procs.append(p)
+        self.observation = self._gather()
+
+    def __len__(self):
+        """Number of races"""
+        return len(self._pipes)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def _gather(self):
+        import numpy as np
+        try:
+            obs = [p.recv() for p in self._pipes]
+        except EOFError:
+            self.close()
+            raise RuntimeError('A VectorRace worker exited, see its output for the error')
+        return {k: np.stack([o[k] for o in obs]) for k in obs[0]}
+
+    def step(self, actions):
+        """Take a step in every race with one action (an Action or a list of Actions, one per player) per race.
+        Returns the stacked observations, running is False for races that are over."""
+        if len(actions) != len(self):
+            raise ValueError('Expected %d actions, got %d' % (len(self), len(actions)))
+        for p, a in zip(self._pipes, actions):
+            p.send(('step', a))
+        self.observation = self._gather()
+        return self.observation
+
+    def restart(self):
+        """Restart all races and return the stacked observations"""
+        for p in self._pipes:
+            p.send(('restart', None))
+        self.observation = self._gather()
+        return self.observation
+
+    def close(self):
+        """Stop all races and their worker processes"""
+        for p in self._pipes:
+            try:
+                p.send(('close', None))
+            except (BrokenPipeError, OSError):
+                pass
+        for p in self._procs:
+            p.join()
+        self._pipes, self._procs = [], []
+)py";
+}
+
+void defineVectorRace(py::module & m) {
+	py::dict scope;
+	scope["__name__"] = m.attr("__name__");
+	scope["__builtins__"] = py::module::import("builtins");
+	py::exec(VECTOR_RACE_SOURCE, scope);
+	for (const char * name: {"_vector_race_observe", "_vector_race_worker", "VectorRace"})
+		m.attr(name) = scope[name];
+}
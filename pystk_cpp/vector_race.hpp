@@ -0,0 +1,7 @@
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+// Adds pystk.VectorRace: N races, one per worker process, stepped in lock-step. SuperTuxKart only allows one race
+// per process, so the races are spread over processes and the class is written in python on top of multiprocessing.
+void defineVectorRace(pybind11::module & m);
@@ -21,6 +21,7 @@
 #include "animations/ipo.hpp"
 #include "io/file_manager.hpp"
 #include "io/xml_node.hpp"
+#include "utils/snapshot.hpp"
 #include "utils/vs.hpp"
 
 #include <algorithm>
@@ -99,6 +100,22 @@ void AnimationBase::reset()
     }
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the current animation time into a snapshot. */
+void AnimationBase::saveState(Snapshot *s) const
+{
+    s->add(m_current_time);
+    s->add(m_playing);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the animation time saved with saveState. */
+void AnimationBase::restoreState(Snapshot *s)
+{
+    s->get(&m_current_time);
+    s->get(&m_playing);
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Updates the time, position and rotation. Called once per frame.
  *  \param dt Time since last call.
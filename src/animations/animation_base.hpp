@@ -34,6 +34,7 @@
 
 #include <algorithm>
 
+class Snapshot;
 class XMLNode;
 
 /**
@@ -84,6 +85,8 @@ public:
     void         setInitialTransform(const Vec3 &xyz,
                                      const Vec3 &hpr);
     void         reset();
+    void         saveState(Snapshot *s) const;
+    void         restoreState(Snapshot *s);
     // ------------------------------------------------------------------------
     /** Disables or enables an animation. */
     void         setPlaying(bool playing) {m_playing = playing; }
@@ -661,6 +661,7 @@ bool UserConfigParams::m_dynamic_lights = true;
 bool UserConfigParams::m_dof = false;
 float UserConfigParams::m_scale_rtts_factor = 1.0f;
 int UserConfigParams::m_max_texture_size = 512;
+bool UserConfigParams::m_physics_only = false;
 
 int UserConfigParams::m_particles_effects = 2;
 bool UserConfigParams::m_animated_characters = true;
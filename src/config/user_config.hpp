@@ -396,6 +396,8 @@ struct UserConfigParams
     static bool m_dof;
     static float m_scale_rtts_factor;
     static int m_max_texture_size;
+    /** Nothing is rendered, meshes are only loaded for the physics. */
+    static bool m_physics_only;
 
     // ---- Graphic Quality;
     static int m_particles_effects;
@@ -56,6 +56,7 @@ void CentralVideoSettings::init()
     hasBGRA = false;
     hasColorBufferFloat = false;
     hasTextureBufferObject = false;
+    hasProgramBinary = false;
     m_need_vertex_id_workaround = false;
 
     // Call to glGetIntegerv should not be made if --no-graphics is used
@@ -176,6 +177,12 @@ void CentralVideoSettings::init()
             hasInstancedArrays = true;
             Log::info("GLDriver", "ARB Instanced Arrays Present");
         }
+        if (!GraphicsRestrictions::isDisabled(GraphicsRestrictions::GR_PROGRAM_BINARY) &&
+            hasGLExtension("GL_ARB_get_program_binary"))
+        {
+            hasProgramBinary = true;
+            Log::info("GLDriver", "ARB Get Program Binary Present");
+        }
 
         // Check all extensions required by SP
         m_supports_sp = isARBInstancedArraysUsable() &&
@@ -214,6 +221,13 @@ void CentralVideoSettings::init()
             hasUBO = true;
             Log::info("GLDriver", "ARB Uniform Buffer Object Present");
         }
+
+        if (!GraphicsRestrictions::isDisabled(GraphicsRestrictions::GR_PROGRAM_BINARY) &&
+            m_glsl == true)
+        {
+            hasProgramBinary = true;
+            Log::info("GLDriver", "Program Binary Present");
+        }
         
         if (!GraphicsRestrictions::isDisabled(GraphicsRestrictions::GR_TEXTURE_FORMAT_BGRA8888) &&
             (hasGLExtension("GL_IMG_texture_format_BGRA8888") ||
@@ -252,6 +266,14 @@ void CentralVideoSettings::init()
         }
 #endif
 
+        // Some drivers support the extension without any binary format
+        if (hasProgramBinary)
+        {
+            GLint num_formats = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+            hasProgramBinary = num_formats > 0;
+        }
+
         // Only unset the high def textures if they are set as default. If the
         // user has enabled them (bit 1 set), then leave them enabled.
         if (GraphicsRestrictions::isDisabled(GraphicsRestrictions::GR_HIGHDEFINITION_TEXTURES) &&
@@ -455,4 +477,9 @@ bool CentralVideoSettings::isARBTextureBufferObjectUsable() const
     return hasTextureBufferObject;
 }
 
+bool CentralVideoSettings::isARBGetProgramBinaryUsable() const
+{
+    return hasProgramBinary;
+}
+
 #endif   // !SERVER_ONLY
@@ -49,6 +49,7 @@ private:
     bool hasBGRA;
     bool hasColorBufferFloat;
     bool hasTextureBufferObject;
+    bool hasProgramBinary;
     bool m_need_vertex_id_workaround;
 public:
     static bool m_supports_sp;
@@ -83,6 +84,7 @@ public:
     bool isEXTTextureFormatBGRA8888Usable() const;
     bool isEXTColorBufferFloatUsable() const;
     bool isARBTextureBufferObjectUsable() const;
+    bool isARBGetProgramBinaryUsable() const;
 
     // Are all required extensions available for feature support
     bool supportsComputeShadersFiltering() const;
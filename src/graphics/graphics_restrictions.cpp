@@ -44,7 +44,7 @@ namespace GraphicsRestrictions
         /** The list of names used in the XML file for the graphics
          *  restriction types. They must be in the same order as the types. */
 
-        std::array<std::string, 32> m_names_of_restrictions =
+        std::array<std::string, 33> m_names_of_restrictions =
         {
             {
                 "UniformBufferObject",
@@ -78,7 +78,8 @@ namespace GraphicsRestrictions
                 "HardwareSkinning",
                 "NpotTextures",
                 "TextureBufferObject",
-                "SystemScreenKeyboard"
+                "SystemScreenKeyboard",
+                "ProgramBinary"
             }
         };
     }   // namespace Private
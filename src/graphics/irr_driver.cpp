@@ -216,7 +216,9 @@ void IrrDriver::initDevice()
                "GLSL not supported by driver");
     }
 	m_renderer = new ShaderBasedRenderer();
-	preloadShaders();
+	// Nothing is drawn in physics only mode, the 2d shaders are not needed
+	if (!UserConfigParams::m_physics_only)
+		preloadShaders();
 #endif
 
     if (UserConfigParams::m_shadows_resolution != 0 &&
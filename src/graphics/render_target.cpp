@@ -30,7 +30,7 @@ RenderTarget::RenderTarget(const irr::core::dimension2du &dimension,
                                  ShaderBasedRenderer *renderer)
                : m_renderer(renderer), m_name(name)
 {
-    m_rtts = new RTT(dimension.Width, dimension.Height);
+    m_rtts = renderer->getSharedRTTs(dimension);
     m_frame_buffer = NULL;
 }   // RenderTarget
 
@@ -38,16 +38,15 @@ RenderTarget::RenderTarget(const irr::core::dimension2du &dimension,
 
 RenderTarget::~RenderTarget()
 {
-    delete m_rtts;
 }   // ~RenderTarget
 
 //-----------------------------------------------------------------------------
 void RenderTarget::renderToTexture(irr::scene::ICameraSceneNode* camera,
-                                      float dt)
+                                      float dt, bool new_frame)
 {
     m_frame_buffer = NULL;
     camera->setAspectRatio(1.f * m_rtts->getWidth() / m_rtts->getHeight());
-    m_renderer->renderToTexture(this, camera, dt);
+    m_renderer->renderToTexture(this, camera, dt, new_frame);
 }   // renderToTexture
 
 //-----------------------------------------------------------------------------
@@ -19,6 +19,7 @@
 #define HEADER_RENDER_TARGET_HPP
 
 #include <irrlicht.h>
+#include <memory>
 #include <string>
 #include "utils/no_copy.hpp"
 
@@ -32,7 +33,8 @@ class RenderTarget: public NoCopy
 private:
     ShaderBasedRenderer* m_renderer;
     std::string m_name;
-    RTT* m_rtts;
+    /** Shared with all other render targets of the same size. */
+    std::shared_ptr<RTT> m_rtts;
     FrameBuffer* m_frame_buffer;
 
 public:
@@ -45,9 +47,10 @@ public:
                      const irr::video::SColor &colors,
                      bool use_alpha_channel_of_texture) const;
     irr::core::dimension2du getTextureSize() const;
-    void renderToTexture(irr::scene::ICameraSceneNode* camera, float dt);
+    void renderToTexture(irr::scene::ICameraSceneNode* camera, float dt,
+                         bool new_frame = true);
     void setFrameBuffer(FrameBuffer* fb) { m_frame_buffer = fb; }
-    virtual RTT* getRTTs() { return m_rtts; }
+    virtual RTT* getRTTs() { return m_rtts.get(); }
 };
 #endif
 #endif
@@ -86,6 +86,33 @@ protected:
     {
         loadAndAttachShader(shader_type, std::string(name), args...);
     }   // loadAndAttachShader
+    // ========================================================================
+    /** Ends recursion. */
+    template<typename ... Types>
+    void getShaderFileList(ShaderFilesManager::ShaderFileList* files)
+    {
+        return;
+    }   // getShaderFileList
+    // ------------------------------------------------------------------------
+    /** Collects the names and types of the shader files of a program, in the
+     *  order loadAndAttachShader() loads them. */
+    template<typename ... Types>
+    void getShaderFileList(ShaderFilesManager::ShaderFileList* files,
+                           GLint shader_type, const std::string &name,
+                           Types ... args)
+    {
+        files->emplace_back(name, shader_type);
+        getShaderFileList(files, args...);
+    }   // getShaderFileList
+    // ------------------------------------------------------------------------
+    /** Convenience interface using const char. */
+    template<typename ... Types>
+    void getShaderFileList(ShaderFilesManager::ShaderFileList* files,
+                           GLint shader_type, const char *name,
+                           Types ... args)
+    {
+        getShaderFileList(files, shader_type, std::string(name), args...);
+    }   // getShaderFileList
 
 public:
         ShaderBase();
@@ -359,12 +386,21 @@ public:
     }   // Shader
 
     // ------------------------------------------------------------------------
-    /** Load a list of shaders and links them all together.
+    /** Load a list of shaders and links them all together. If the program
+     *  is in the program binary cache, the shaders are not compiled.
      */
     template<typename ... Types>
     void loadProgram(AttributeType type, Types ... args)
     {
         m_program = glCreateProgram();
+        ShaderFilesManager::ShaderFileList files;
+        getShaderFileList(&files, args...);
+        uint64_t hash;
+        if (ShaderFilesManager::getInstance()->loadProgramBinary(m_program,
+                                                                 files, &hash))
+        {
+            return;
+        }
         loadAndAttachShader(args...);
         glLinkProgram(m_program);
 
@@ -381,6 +417,11 @@ public:
             Log::error("Shader", error_message);
             delete[] error_message;
         }
+        else
+        {
+            ShaderFilesManager::getInstance()->saveProgramBinary(m_program,
+                                                                 hash);
+        }
         // After linking all shaders can be detached
         for (auto shader : m_shaders)
         {
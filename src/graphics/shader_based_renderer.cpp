@@ -832,9 +832,36 @@ std::unique_ptr<RenderTarget> ShaderBasedRenderer::createRenderTarget(const irr:
 }
 
 // ----------------------------------------------------------------------------
+/** Returns the RTTs used to render views of the given size. All render
+ *  targets of the same size share one set of RTTs (the whole deferred
+ *  pipeline with its post-processing and shadow buffers), which is freed
+ *  once the last of them is destroyed. The result of a view is only valid
+ *  until the next view is rendered, so it has to be copied out before.
+ */
+std::shared_ptr<RTT> ShaderBasedRenderer::getSharedRTTs(
+                                   const irr::core::dimension2du &dimension)
+{
+    std::weak_ptr<RTT> &shared =
+        m_shared_rtts[std::make_pair(dimension.Width, dimension.Height)];
+    std::shared_ptr<RTT> rtts = shared.lock();
+    if (!rtts)
+    {
+        rtts = std::make_shared<RTT>(dimension.Width, dimension.Height);
+        shared = rtts;
+    }
+    return rtts;
+}   // getSharedRTTs
+
+// ----------------------------------------------------------------------------
+/** Renders the scene from a camera into the RTTs of a render target.
+ *  \param new_frame If false, another view of the same frame was rendered
+ *         before, so the scene is already animated and the (camera
+ *         independent) lighting data is uploaded. Only the camera dependent
+ *         work (culling, shadow cascades and all passes) is done again.
+ */
 void ShaderBasedRenderer::renderToTexture(RenderTarget *render_target,
                                           irr::scene::ICameraSceneNode* camera,
-                                          float dt)
+                                          float dt, bool new_frame)
 {
     // For render to texture no triple buffering of ubo is used
     SP::sp_cur_player = 0;
@@ -845,10 +872,13 @@ void ShaderBasedRenderer::renderToTexture(RenderTarget *render_target,
     m_rtts->getFBO(FBO_COLORS).bind();
 
     irr_driver->getSceneManager()->setActiveCamera(camera);
-    static_cast<scene::CSceneManager *>(irr_driver->getSceneManager())
-        ->OnAnimate(os::Timer::getTime());
+    if (new_frame)
+    {
+        static_cast<scene::CSceneManager *>(irr_driver->getSceneManager())
+            ->OnAnimate(os::Timer::getTime());
+    }
     computeMatrixesAndCameras(camera, m_rtts->getWidth(), m_rtts->getHeight());
-    if (CVS->isARBUniformBufferObjectUsable())
+    if (new_frame && CVS->isARBUniformBufferObjectUsable())
         uploadLightingData();
 
     if (CVS->isDeferredEnabled() && Physics::getInstance()->isInit() /* workaround for some bug that renders the minimap before Physics is created*/)
@@ -26,7 +26,9 @@
 #include "graphics/shadow_matrices.hpp"
 #include "utils/cpp2011.hpp"
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
 
 class AbstractGeometryPasses;
 class Camera;
@@ -49,6 +51,10 @@ private:
     PostProcessing             *m_post_processing;
 	TrackRenderer              *m_track_renderer;
 
+    /** The intermediate RTTs shared by all render targets of a size. */
+    std::map<std::pair<unsigned int, unsigned int>,
+             std::weak_ptr<RTT> > m_shared_rtts;
+
     void prepareForwardRenderer();
 
     void uploadLightingData() const;
@@ -103,9 +109,11 @@ public:
     std::unique_ptr<RenderTarget> createRenderTarget(const irr::core::dimension2du &dimension,
                                                      const std::string &name) OVERRIDE;
     
+    std::shared_ptr<RTT> getSharedRTTs(const irr::core::dimension2du &dimension);
+
     void renderToTexture(RenderTarget *render_target,
                          irr::scene::ICameraSceneNode* camera,
-                         float dt);
+                         float dt, bool new_frame = true);
 
     RTT* getRTTs() { return m_rtts; }
     ShadowMatrices* getShadowMatrices() { return &m_shadow_matrices; }
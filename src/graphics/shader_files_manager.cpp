@@ -26,9 +26,34 @@
 #include "utils/log.hpp"
 #include "utils/string_utils.hpp"
 
+#include <cstring>
 #include <fstream>
 #include <sstream>
 
+namespace
+{
+    /** Identifies the file format of a program binary. */
+    const char PROGRAM_BINARY_MAGIC[8] = "STKPRG1";
+
+    /** Header of a program binary file, followed by the binary. */
+    struct ProgramBinaryHeader
+    {
+        char     m_magic[8];
+        uint32_t m_format;
+        uint32_t m_length;
+        uint64_t m_hash;
+    };   // ProgramBinaryHeader
+
+    // ------------------------------------------------------------------------
+    /** Returns the file of a program binary in the cache. */
+    std::string getProgramBinaryFile(uint64_t hash)
+    {
+        char name[32];
+        sprintf(name, "%016llx.bin", (unsigned long long)hash);
+        return file_manager->getCachedTexturesDir() + "programs/" + name;
+    }   // getProgramBinaryFile
+}   // namespace
+
 // ----------------------------------------------------------------------------
 /** Returns a string with the content of header.txt (which contains basic
  *  shader defines).
@@ -118,21 +143,14 @@ void ShaderFilesManager::readFile(const std::string& file,
 }
 
 // ----------------------------------------------------------------------------
-/** Loads a single shader. This is NOT cached, use addShaderFile for that.
- *  \param file Filename of the shader to load.
+/** Returns the source of a shader with the version, extensions and defines
+ *  for the current driver and settings, and all included files.
+ *  \param full_path Full path of the shader file.
  *  \param type Type of the shader.
  */
-ShaderFilesManager::SharedShader ShaderFilesManager::loadShader
-    (const std::string& full_path, unsigned type)
+std::string ShaderFilesManager::getShaderSource(const std::string& full_path,
+                                                unsigned type)
 {
-    GLuint* ss_ptr = new GLuint;
-    *ss_ptr = glCreateShader(type);
-    SharedShader ss(ss_ptr, [](GLuint* ss)
-    {
-        glDeleteShader(*ss);
-        delete ss;
-    });
-
     std::ostringstream code;
 #if !defined(USE_GLES2)
     code << "#version " << CVS->getGLSLVersion()<<"\n";
@@ -209,10 +227,28 @@ ShaderFilesManager::SharedShader ShaderFilesManager::loadShader
     code << getHeader();
 
     readFile(full_path, code);
+    return code.str();
+}   // getShaderSource
+
+// ----------------------------------------------------------------------------
+/** Loads a single shader. This is NOT cached, use addShaderFile for that.
+ *  \param file Filename of the shader to load.
+ *  \param type Type of the shader.
+ */
+ShaderFilesManager::SharedShader ShaderFilesManager::loadShader
+    (const std::string& full_path, unsigned type)
+{
+    GLuint* ss_ptr = new GLuint;
+    *ss_ptr = glCreateShader(type);
+    SharedShader ss(ss_ptr, [](GLuint* ss)
+    {
+        glDeleteShader(*ss);
+        delete ss;
+    });
 
     Log::info("ShaderFilesManager", "Compiling shader: %s",
         full_path.c_str());
-    const std::string &source  = code.str();
+    const std::string source   = getShaderSource(full_path, type);
     char const *source_pointer = source.c_str();
     int len                    = (int)source.size();
     glShaderSource(*ss, 1, &source_pointer, &len);
@@ -260,6 +296,18 @@ ShaderFilesManager::SharedShader ShaderFilesManager::addShaderFile
     return ss;
 }   // addShaderFile
 
+// ----------------------------------------------------------------------------
+/** Returns the full path of a shader file, file names without a directory
+ *  are in the official shader directory.
+ */
+std::string ShaderFilesManager::getFullPath(const std::string& file) const
+{
+    return (file.find('/') != std::string::npos ||
+        file.find('\\') != std::string::npos) ?
+        file : std::string(file_manager->getFileSystem()->getAbsolutePath
+        (file_manager->getShadersDir().c_str()).c_str()) + file;
+}   // getFullPath
+
 // ----------------------------------------------------------------------------
 /** Get a shader file. If the shader is not already in the cache it will be
  *  loaded and cached.
@@ -269,10 +317,7 @@ ShaderFilesManager::SharedShader ShaderFilesManager::addShaderFile
 ShaderFilesManager::SharedShader ShaderFilesManager::getShaderFile
     (const std::string &file, unsigned type)
 {
-    const std::string full_path = (file.find('/') != std::string::npos ||
-        file.find('\\') != std::string::npos) ?
-        file : std::string(file_manager->getFileSystem()->getAbsolutePath
-        (file_manager->getShadersDir().c_str()).c_str()) + file;
+    const std::string full_path = getFullPath(file);
     // found in cache
     auto it = m_shader_files_loaded.find(full_path);
     if (it != m_shader_files_loaded.end())
@@ -282,4 +327,131 @@ ShaderFilesManager::SharedShader ShaderFilesManager::getShaderFile
     return addShaderFile(full_path, type);
 }   // getShaderFile
 
+// ----------------------------------------------------------------------------
+/** Returns a hash of everything the binary of a program depends on: the
+ *  driver, and the type and source (with all defines) of each shader file.
+ *  \param files The shader files of the program.
+ */
+uint64_t ShaderFilesManager::getProgramHash(const ShaderFileList& files)
+{
+    if (m_driver_hash == 0)
+    {
+        std::string driver = std::string((char*)glGetString(GL_VENDOR)) +
+            "\n" + (char*)glGetString(GL_RENDERER) + "\n" +
+            (char*)glGetString(GL_VERSION);
+        m_driver_hash = FileUtils::hashBytes(driver.data(), driver.size());
+    }
+    uint64_t hash = m_driver_hash;
+    for (auto& f : files)
+    {
+        const std::string full_path = getFullPath(f.first);
+        auto it = m_source_hashes.find(full_path);
+        if (it == m_source_hashes.end())
+        {
+            const std::string source = getShaderSource(full_path, f.second);
+            it = m_source_hashes.emplace(full_path,
+                FileUtils::hashBytes(source.data(), source.size())).first;
+        }
+        hash = FileUtils::hashBytes(&f.second, sizeof(f.second), hash);
+        hash = FileUtils::hashBytes(&it->second, sizeof(it->second), hash);
+    }
+    return hash;
+}   // getProgramHash
+
+// ----------------------------------------------------------------------------
+/** Loads the binary of a program from the program binary cache, so that its
+ *  shader files don't need to be compiled. If this fails, the shader files
+ *  must be attached and linked as usual, and the program saved with
+ *  saveProgramBinary().
+ *  \param program The program, nothing must be attached to it.
+ *  \param files The shader files of the program.
+ *  \param hash Set to the hash of the program (0 if program binaries are
+ *         not supported), for saveProgramBinary().
+ */
+bool ShaderFilesManager::loadProgramBinary(GLuint program,
+                                           const ShaderFileList& files,
+                                           uint64_t* hash)
+{
+    *hash = 0;
+    if (!CVS->isARBGetProgramBinaryUsable())
+        return false;
+    *hash = getProgramHash(files);
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    const std::string file = getProgramBinaryFile(*hash);
+    FILE* f = FileUtils::fopenU8Path(file, "rb");
+    if (!f)
+        return false;
+    ProgramBinaryHeader header;
+    std::vector<uint8_t> binary;
+    bool valid = fread(&header, sizeof(header), 1, f) == 1 &&
+        memcmp(header.m_magic, PROGRAM_BINARY_MAGIC,
+               sizeof(header.m_magic)) == 0 &&
+        header.m_hash == *hash;
+    if (valid)
+    {
+        binary.resize(header.m_length);
+        valid = fread(binary.data(), 1, binary.size(), f) == binary.size();
+    }
+    fclose(f);
+    if (!valid)
+        return false;
+
+    glProgramBinary(program, header.m_format, binary.data(),
+        (GLsizei)binary.size());
+    GLint result = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &result);
+    glGetError();
+    if (result == GL_FALSE)
+    {
+        // E.g. the driver was updated without changing its version string
+        Log::info("ShaderFilesManager", "Program binary '%s' is outdated.",
+            file.c_str());
+        return false;
+    }
+    return true;
+}   // loadProgramBinary
+
+// ----------------------------------------------------------------------------
+/** Saves the binary of a linked program to the program binary cache. It is
+ *  written to a temporary file first, so that other processes never read a
+ *  partially written file.
+ *  \param program The linked program.
+ *  \param hash The hash from loadProgramBinary(), nothing is saved if it
+ *         is 0.
+ */
+void ShaderFilesManager::saveProgramBinary(GLuint program, uint64_t hash)
+{
+    if (hash == 0)
+        return;
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+    std::vector<uint8_t> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+    if (length <= 0)
+        return;
+
+    const std::string file = getProgramBinaryFile(hash);
+    if (!file_manager->checkAndCreateDirectoryP(StringUtils::getPath(file)))
+        return;
+    ProgramBinaryHeader header;
+    memcpy(header.m_magic, PROGRAM_BINARY_MAGIC, sizeof(header.m_magic));
+    header.m_format = format;
+    header.m_length = (uint32_t)length;
+    header.m_hash   = hash;
+    bool success = FileUtils::writeFileAtomic(file, [&](FILE* f)
+    {
+        return fwrite(&header, sizeof(header), 1, f) == 1 &&
+            fwrite(binary.data(), 1, length, f) == (size_t)length;
+    });
+    if (!success)
+    {
+        Log::warn("ShaderFilesManager", "Can't write program binary '%s'.",
+            file.c_str());
+    }
+}   // saveProgramBinary
+
 #endif   // !SERVER_ONLY
@@ -27,12 +27,19 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 class ShaderFilesManager : public Singleton<ShaderFilesManager>, NoCopy
 {
+public:
+    /** Names and types of the shader files of a program. */
+    typedef std::vector<std::pair<std::string, unsigned> > ShaderFileList;
+
 private:
     typedef std::shared_ptr<GLuint> SharedShader;
     /**
@@ -41,17 +48,31 @@ private:
      */
     std::unordered_map<std::string, SharedShader> m_shader_files_loaded;
 
+    /** Map from a filename in full path to the hash of its source (with all
+     *  defines), used for the program binary cache. */
+    std::unordered_map<std::string, uint64_t> m_source_hashes;
+
+    /** Hash of the driver vendor, renderer and version, 0 until the first
+     *  program hash is computed. */
+    uint64_t m_driver_hash;
+
     // ------------------------------------------------------------------------
     const std::string& getHeader();
     // ------------------------------------------------------------------------
     void readFile(const std::string& file, std::ostringstream& code,
                   bool not_header = true);
     // ------------------------------------------------------------------------
+    std::string getFullPath(const std::string& file) const;
+    // ------------------------------------------------------------------------
+    std::string getShaderSource(const std::string& full_path, unsigned type);
+    // ------------------------------------------------------------------------
     SharedShader addShaderFile(const std::string& full_path, unsigned type);
+    // ------------------------------------------------------------------------
+    uint64_t getProgramHash(const ShaderFileList& files);
 
 public:
     // ------------------------------------------------------------------------
-    ShaderFilesManager() {}
+    ShaderFilesManager() : m_driver_hash(0) {}
     // ------------------------------------------------------------------------
     ~ShaderFilesManager()
     {
@@ -89,6 +110,11 @@ public:
     SharedShader loadShader(const std::string& full_path, unsigned type);
     // ------------------------------------------------------------------------
     SharedShader getShaderFile(const std::string& file, unsigned type);
+    // ------------------------------------------------------------------------
+    bool loadProgramBinary(GLuint program, const ShaderFileList& files,
+                           uint64_t* hash);
+    // ------------------------------------------------------------------------
+    void saveProgramBinary(GLuint program, uint64_t hash);
 
 };   // ShaderFilesManager
 
@@ -1346,12 +1346,13 @@ void drawGlow()
 void draw(RenderPass rp, DrawCallType dct)
 {
 #ifndef SERVER_ONLY
-    std::stringstream profiler_name;
-    profiler_name << "SP::Draw " << dct << " with " << rp;
-    PROFILER_PUSH_CPU_MARKER(profiler_name.str().c_str(),
-        (uint8_t)(float(dct + rp + 2) / float(DCT_FOR_VAO + RP_COUNT) * 255.0f),
-        (uint8_t)(float(dct + 1) / (float)DCT_FOR_VAO * 255.0f) ,
-        (uint8_t)(float(rp + 1) / (float)RP_COUNT * 255.0f));
+    // The marker name is not constant, so it is looked up on each call
+    if (profiler.isEnabled())
+    {
+        std::stringstream profiler_name;
+        profiler_name << "SP::Draw " << dct << " with " << rp;
+        profiler.pushCPUMarker(profiler_name.str().c_str());
+    }
 
     assert(dct < DCT_FOR_VAO);
     for (unsigned i = 0; i < g_final_draw_calls[dct].size(); i++)
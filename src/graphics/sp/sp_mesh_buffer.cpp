@@ -17,6 +17,7 @@
 
 #include "graphics/sp/sp_mesh_buffer.hpp"
 #include "graphics/sp/sp_texture.hpp"
+#include "config/user_config.hpp"
 #include "graphics/central_settings.hpp"
 #include "graphics/graphics_restrictions.hpp"
 #include "graphics/material.hpp"
@@ -114,6 +115,12 @@ void SPMeshBuffer::uploadGLMesh()
     {
         return;
     }
+    // Without rendering the mesh is only needed for the physics, so neither
+    // the vertex buffers are created nor the textures loaded and decoded.
+    if (UserConfigParams::m_physics_only)
+    {
+        return;
+    }
     m_uploaded_gl = true;
 #ifndef SERVER_ONLY
     if (!m_shaders[0])
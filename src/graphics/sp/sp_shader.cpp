@@ -16,6 +16,7 @@
 //  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include "graphics/sp/sp_shader.hpp"
+#include "config/user_config.hpp"
 #include "graphics/central_settings.hpp"
 #include "graphics/shader_files_manager.hpp"
 #include "graphics/sp/sp_base.hpp"
@@ -57,7 +58,10 @@ SPShader::SPShader(const std::string& name,
 #endif
     
     memset(m_program, 0, 12);
-    m_init_function(this);
+    // Nothing is drawn in physics only mode, the shader only gives its name
+    // and flags to the mesh buffers, so its programs are never built
+    if (!UserConfigParams::m_physics_only)
+        m_init_function(this);
 }
 // ----------------------------------------------------------------------------
 void SPShader::addShaderFile(const std::string& name, GLint shader_type,
@@ -68,13 +72,7 @@ void SPShader::addShaderFile(const std::string& name, GLint shader_type,
     {
         m_program[rp] = glCreateProgram();
     }
-    auto shader_file = ShaderFilesManager::getInstance()
-        ->getShaderFile(name, shader_type);
-    if (shader_file)
-    {
-        m_shader_files.push_back(shader_file);
-        glAttachShader(m_program[rp], *shader_file);
-    }
+    m_shader_file_names[rp].emplace_back(name, shader_type);
 #endif
 }   // addShaderFile
 
@@ -82,27 +80,49 @@ void SPShader::addShaderFile(const std::string& name, GLint shader_type,
 void SPShader::linkShaderFiles(RenderPass rp)
 {
 #ifndef SERVER_ONLY
-    glLinkProgram(m_program[rp]);
-    GLint result = GL_FALSE;
-    glGetProgramiv(m_program[rp], GL_LINK_STATUS, &result);
-    if (result == GL_FALSE)
-    {
-        Log::error("SPShader", "Error when linking shader %s in pass %d",
-            m_name.c_str(), (int)rp);
-        int info_length;
-        glGetProgramiv(m_program[rp], GL_INFO_LOG_LENGTH, &info_length);
-        char *error_message = new char[info_length];
-        glGetProgramInfoLog(m_program[rp], info_length, NULL, error_message);
-        Log::error("SPShader", error_message);
-        delete[] error_message;
-    }
-    // After linking all shaders can be detached
-    GLuint shaders[10] = {};
-    GLsizei count = 0;
-    glGetAttachedShaders(m_program[rp], 10, &count, shaders);
-    for (unsigned i = 0; i < (unsigned)count; i++)
+    // Shader files are only compiled if the program binary is not cached
+    uint64_t hash;
+    GLint result = GL_TRUE;
+    if (!ShaderFilesManager::getInstance()->loadProgramBinary(m_program[rp],
+        m_shader_file_names[rp], &hash))
     {
-        glDetachShader(m_program[rp], shaders[i]);
+        for (auto& f : m_shader_file_names[rp])
+        {
+            auto shader_file = ShaderFilesManager::getInstance()
+                ->getShaderFile(f.first, f.second);
+            if (shader_file)
+            {
+                m_shader_files.push_back(shader_file);
+                glAttachShader(m_program[rp], *shader_file);
+            }
+        }
+        glLinkProgram(m_program[rp]);
+        glGetProgramiv(m_program[rp], GL_LINK_STATUS, &result);
+        if (result == GL_FALSE)
+        {
+            Log::error("SPShader", "Error when linking shader %s in pass %d",
+                m_name.c_str(), (int)rp);
+            int info_length;
+            glGetProgramiv(m_program[rp], GL_INFO_LOG_LENGTH, &info_length);
+            char *error_message = new char[info_length];
+            glGetProgramInfoLog(m_program[rp], info_length, NULL,
+                error_message);
+            Log::error("SPShader", error_message);
+            delete[] error_message;
+        }
+        else
+        {
+            ShaderFilesManager::getInstance()->saveProgramBinary(
+                m_program[rp], hash);
+        }
+        // After linking all shaders can be detached
+        GLuint shaders[10] = {};
+        GLsizei count = 0;
+        glGetAttachedShaders(m_program[rp], 10, &count, shaders);
+        for (unsigned i = 0; i < (unsigned)count; i++)
+        {
+            glDetachShader(m_program[rp], shaders[i]);
+        }
     }
     if (result == GL_FALSE)
     {
@@ -356,6 +376,7 @@ void SPShader::unload()
         m_samplers[rp].clear();
         m_use_function[rp] = nullptr;
         m_unuse_function[rp] = nullptr;
+        m_shader_file_names[rp].clear();
     }
     m_shader_files.clear();
 #endif
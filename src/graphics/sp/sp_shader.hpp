@@ -90,6 +90,11 @@ private:
 
     std::vector<std::shared_ptr<GLuint> > m_shader_files;
 
+    /** Names and types of the shader files of each pass, they are only
+     *  compiled if the program is not in the program binary cache. */
+    std::vector<std::pair<std::string, unsigned> >
+        m_shader_file_names[RP_COUNT];
+
     GLuint m_program[RP_COUNT];
 
     std::map<unsigned, unsigned> m_samplers[RP_COUNT];
@@ -224,9 +229,12 @@ public:
     // ------------------------------------------------------------------------
     void init()
     {
-        if (!m_shader_files.empty())
+        for (unsigned rp = RP_1ST; rp < RP_COUNT; rp++)
         {
-            return;
+            if (!m_shader_file_names[rp].empty())
+            {
+                return;
+            }
         }
         m_init_function(this);
     }
@@ -22,10 +22,12 @@
 #include "graphics/sp/sp_base.hpp"
 #include "graphics/sp/sp_shader.hpp"
 #include "graphics/sp/sp_shader_manager.hpp"
+#include "graphics/sp/sp_texture_cache.hpp"
 #include "graphics/sp/sp_texture_manager.hpp"
 #include "graphics/central_settings.hpp"
 #include "graphics/irr_driver.hpp"
 #include "graphics/material.hpp"
+#include "utils/file_utils.hpp"
 #include "utils/log.hpp"
 #include "utils/string_utils.hpp"
 
@@ -46,10 +48,6 @@ extern "C"
 
 #include <numeric>
 
-#if !defined(MOBILE_STK)
-static const uint8_t CACHE_VERSION = 1;
-#endif
-
 namespace SP
 {
 // ----------------------------------------------------------------------------
@@ -88,7 +86,8 @@ SPTexture::SPTexture(const std::string& path, Material* m, bool undo_srgb,
 
     m_cache_directory = file_manager->getCachedTexturesDir() +
         cache_subdir + "/" + container_id;
-    file_manager->checkAndCreateDirectoryP(m_cache_directory);
+    m_texture_cache =
+        SPTextureManager::get()->getTextureCache(m_cache_directory);
 
 #endif
 }   // SPTexture
@@ -232,7 +231,7 @@ std::shared_ptr<video::IImage> SPTexture::getTextureImage() const
 }   // getTextureImage
 
 // ----------------------------------------------------------------------------
-bool SPTexture::compressedTexImage2d(std::shared_ptr<video::IImage> texture,
+bool SPTexture::compressedTexImage2d(const uint8_t* compressed,
                                      const std::vector<std::pair
                                      <core::dimension2du, unsigned> >&
                                      mipmap_sizes)
@@ -246,7 +245,6 @@ bool SPTexture::compressedTexImage2d(std::shared_ptr<video::IImage> texture,
     glDeleteTextures(1, &m_texture_name);
     glGenTextures(1, &m_texture_name);
     glBindTexture(GL_TEXTURE_2D, m_texture_name);
-    uint8_t* compressed = (uint8_t*)texture->lock();
     unsigned cur_mipmap_size = 0;
     for (unsigned i = 0; i < mipmap_sizes.size(); i++)
     {
@@ -330,155 +328,162 @@ bool SPTexture::texImage2d(std::shared_ptr<video::IImage> texture,
 }   // texImage2d
 
 // ----------------------------------------------------------------------------
-bool SPTexture::saveCompressedTexture(std::shared_ptr<video::IImage> texture,
-                                      const std::vector<std::pair
-                                      <core::dimension2du, unsigned> >& sizes,
-                                      const std::string& cache_location)
+/** Returns the path of the colorization or alpha mask of this texture, or an
+ *  empty string if it has none.
+ */
+std::string SPTexture::getMaskPath() const
 {
-#if !defined(SERVER_ONLY) && !defined(MOBILE_STK)
-    const unsigned total_size = std::accumulate(sizes.begin(), sizes.end(), 0,
-        [] (const unsigned int previous, const std::pair
-        <core::dimension2du, unsigned>& cur_sizes)
-       { return previous + cur_sizes.second; });
-    io::IWriteFile* file = irr::io::createWriteFile(cache_location.c_str(),
-        false);
-    if (file == NULL)
-    {
-        return true;
-    }
-    file->write(&CACHE_VERSION, 1);
-    const unsigned mm_sizes = (unsigned)sizes.size();
-    file->write(&mm_sizes, 4);
-    for (auto& p : sizes)
-    {
-        file->write(&p.first.Width, 4);
-        file->write(&p.first.Height, 4);
-        file->write(&p.second, 4);
-    }
-    file->write(texture->lock(), total_size);
-    file->drop();
-#endif
-    return true;
-}   // saveCompressedTexture
+    if (!m_material)
+        return "";
+    const std::string& mask = !m_material->getColorizationMask().empty() ?
+        m_material->getColorizationMask() : m_material->getAlphaMask();
+    if (mask.empty())
+        return "";
+    return StringUtils::getPath(m_path) + "/" + mask;
+}   // getMaskPath
 
 // ----------------------------------------------------------------------------
-bool SPTexture::useTextureCache(const std::string& full_path,
-                                std::string* cache_loc)
+/** Returns a hash of the path, size and modification time of the texture
+ *  file and its mask file, or 0 if a file does not exist. It is cheap to
+ *  compute, and is used to find the texture in the cache archive without
+ *  reading the files.
+ */
+uint64_t SPTexture::getFileStamp() const
 {
-#ifndef SERVER_ONLY
-    if (!CVS->isTextureCompressionEnabled() || m_cache_directory.empty())
-    {
-        return false;
-    }
+    // The hash of no bytes, i.e. the FNV-1a offset basis
+    uint64_t stamp = FileUtils::hashBytes(NULL, 0);
+    const std::string files[2] = { m_path, getMaskPath() };
+    for (const std::string& file : files)
+    {
+        if (file.empty())
+            continue;
+        struct stat st;
+        if (FileUtils::statU8Path(file, &st) != 0)
+            return 0;
+        const int64_t size = st.st_size, mtime = st.st_mtime;
+        stamp = FileUtils::hashBytes(file.data(), file.size(), stamp);
+        stamp = FileUtils::hashBytes(&size, sizeof(size), stamp);
+        stamp = FileUtils::hashBytes(&mtime, sizeof(mtime), stamp);
+    }
+    return stamp;
+}   // getFileStamp
+
+// ----------------------------------------------------------------------------
+/** Returns a hash of the content of the texture file and its mask file,
+ *  which identifies the texture in the cache archive, or 0 if a file can't
+ *  be read. Only needed if the file stamp does not match the archive.
+ */
+uint64_t SPTexture::getContentHash() const
+{
+    uint64_t hash = FileUtils::hashFile(m_path);
+    const std::string mask = getMaskPath();
+    if (hash != 0 && !mask.empty())
+        hash = FileUtils::hashFile(mask, hash);
+    return hash;
+}   // getContentHash
 
-    std::string basename = StringUtils::getBasename(m_path);
-    *cache_loc = m_cache_directory + "/" + basename + ".sptz";
+// ----------------------------------------------------------------------------
+/** Loads the texture and uploads it. */
+bool SPTexture::load()
+{
+    prepare();
+    return upload();
+}   // load
 
-    if (file_manager->fileExists(*cache_loc) &&
-        file_manager->fileIsNewer(*cache_loc, m_path))
-    {
-        if (m_material && (!m_material->getColorizationMask().empty() ||
-            m_material->getAlphaMask().empty()))
+// ----------------------------------------------------------------------------
+/** Does the CPU side of loading: finds the compressed mipmaps in the cache
+ *  archive, or decodes the image, applies its mask and generates and
+ *  compresses the mipmaps. It does not use OpenGL, so textures can be
+ *  prepared on worker threads.
+ */
+void SPTexture::prepare()
+{
+#ifndef SERVER_ONLY
+    m_prepared_image.reset();
+    m_prepared_sizes.clear();
+    m_prepared_data = NULL;
+    const std::string name = StringUtils::getBasename(m_path);
+    uint64_t stamp = 0, hash = 0;
+    if (m_texture_cache && CVS->isTextureCompressionEnabled())
+    {
+        // The content is only hashed if the files changed on disk since the
+        // texture was cached (or were e.g. checked out again)
+        stamp = getFileStamp();
+        if (stamp != 0)
         {
-            std::string mask_path = StringUtils::getPath(m_path) + "/" +
-                (!m_material->getColorizationMask().empty() ?
-                m_material->getColorizationMask() :
-                m_material->getAlphaMask());
-            if (!file_manager->fileIsNewer(*cache_loc, mask_path))
+            m_prepared_data =
+                m_texture_cache->find(name, stamp, 0, &m_prepared_sizes);
+            if (!m_prepared_data)
             {
-                return false;
+                hash = getContentHash();
+                if (hash != 0)
+                {
+                    m_prepared_data = m_texture_cache->find(name, stamp,
+                        hash, &m_prepared_sizes);
+                }
             }
+            if (m_prepared_data)
+                return;
         }
-        return true;
     }
-#endif
-    return false;
-}   // useTextureCache
 
-// ----------------------------------------------------------------------------
-std::shared_ptr<video::IImage> SPTexture::getTextureCache(const std::string& p,
-    std::vector<std::pair<core::dimension2du, unsigned> >* sizes)
-{
-    std::shared_ptr<video::IImage> cache;
-#if !(defined(SERVER_ONLY) || defined(MOBILE_STK))
-    io::IReadFile* file = irr::io::createReadFile(p.c_str());
-    if (file == NULL)
-    {
-        return cache;
-    }
-
-    uint8_t cache_version;
-    file->read(&cache_version, 1);
-    if (cache_version != CACHE_VERSION)
+    std::shared_ptr<video::IImage> image = getTextureImage();
+    if (!image)
+        return;
+    std::shared_ptr<video::IImage> mask = getMask(image->getDimension());
+    if (mask)
     {
-        return cache;
+        applyMask(image.get(), mask.get());
     }
 
-    unsigned mm_sizes;
-    file->read(&mm_sizes, 4);
-    sizes->resize(mm_sizes);
-    for (unsigned i = 0; i < mm_sizes; i++)
+    if (!m_cache_directory.empty() && CVS->isTextureCompressionEnabled() &&
+        image->getDimension().Width >= 4 && image->getDimension().Height >= 4)
     {
-        file->read(&((*sizes)[i].first.Width), 4);
-        file->read(&((*sizes)[i].first.Height), 4);
-        file->read(&((*sizes)[i].second), 4);
+        m_prepared_sizes = compressTexture(image);
+        if (hash != 0)
+        {
+            m_texture_cache->add(name, stamp, hash, m_prepared_sizes,
+                (const uint8_t*)image->lock());
+        }
     }
-
-    const unsigned total_cache_size = std::accumulate(sizes->begin(),
-        sizes->end(), 0,[] (const unsigned int previous, const std::pair
-        <core::dimension2du, unsigned>& cur_sizes)
-       { return previous + cur_sizes.second; });
-    cache.reset(irr_driver->getVideoDriver()->createImage(video::ECF_A8R8G8B8,
-        (*sizes)[0].first));
-    assert(cache->getReferenceCount() == 1);
-    file->read(cache->lock(), total_cache_size);
-    file->drop();
+    m_prepared_image = image;
 #endif
-    return cache;
-}   // getTextureCache
+}   // prepare
 
 // ----------------------------------------------------------------------------
-bool SPTexture::load()
+/** Uploads the result of prepare() to OpenGL and frees it. Must be called
+ *  on the thread that owns the OpenGL context.
+ */
+bool SPTexture::upload()
 {
 #ifndef SERVER_ONLY
-    std::string cache_loc;
-    if (useTextureCache(m_path, &cache_loc))
+    if (m_prepared_data)
     {
-        std::vector<std::pair<core::dimension2du, unsigned> > sizes;
-        std::shared_ptr<video::IImage> cache = getTextureCache(cache_loc,
-            &sizes);
-        if (cache)
-            return compressedTexImage2d(cache, sizes);
+        compressedTexImage2d(m_prepared_data, m_prepared_sizes);
+        m_prepared_data = NULL;
+        m_prepared_sizes.clear();
+        return true;
     }
-
-    std::shared_ptr<video::IImage> image = getTextureImage();
-    if (!image)
+    if (!m_prepared_image)
     {
         m_width.store(2);
         m_height.store(2);
         return true;
     }
-    std::shared_ptr<video::IImage> mask = getMask(image->getDimension());
-    if (mask)
+    if (!m_prepared_sizes.empty())
     {
-        applyMask(image.get(), mask.get());
+        compressedTexImage2d((const uint8_t*)m_prepared_image->lock(),
+            m_prepared_sizes);
     }
-    std::shared_ptr<video::IImage> mipmaps;
-
-    if (!m_cache_directory.empty() && CVS->isTextureCompressionEnabled() &&
-        image->getDimension().Width >= 4 && image->getDimension().Height >= 4)
+    else
     {
-        auto r = compressTexture(image);
-        compressedTexImage2d(image, r);
-        if (!cache_loc.empty())
-            saveCompressedTexture(image, r, cache_loc);
-    } else {
-        texImage2d(image, mipmaps);
+        texImage2d(m_prepared_image, NULL);
     }
-
+    m_prepared_image.reset();
+    m_prepared_sizes.clear();
 #endif
     return true;
-}   // load
+}   // upload
 
 // ----------------------------------------------------------------------------
 std::shared_ptr<video::IImage>
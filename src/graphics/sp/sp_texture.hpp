@@ -40,6 +40,7 @@ using namespace irr;
 
 namespace SP
 {
+class SPTextureCache;
 
 class SPTexture : public NoCopy
 {
@@ -58,6 +59,20 @@ private:
 
     const bool m_undo_srgb;
 
+    /** The archive of the cache directory, NULL if textures are not
+     *  compressed. */
+    SPTextureCache* m_texture_cache = NULL;
+
+    /** The decoded (and possibly compressed) image and its mipmap sizes
+     *  (empty if not compressed) from prepare(), consumed by upload(). */
+    std::shared_ptr<video::IImage> m_prepared_image;
+
+    std::vector<std::pair<core::dimension2du, unsigned> > m_prepared_sizes;
+
+    /** The compressed mipmaps in the texture cache archive, if prepare()
+     *  found them there instead of creating m_prepared_image. */
+    const uint8_t* m_prepared_data = NULL;
+
     // ------------------------------------------------------------------------
     void squishCompressImage(uint8_t* rgba, int width, int height, int pitch,
                              void* blocks, unsigned flags);
@@ -140,22 +155,18 @@ private:
     bool texImage2d(std::shared_ptr<video::IImage> texture,
         std::shared_ptr<video::IImage> mipmaps);
     // ------------------------------------------------------------------------
-    bool compressedTexImage2d(std::shared_ptr<video::IImage> texture,
+    bool compressedTexImage2d(const uint8_t* compressed,
                               const std::vector<std::pair<core::dimension2du,
                               unsigned> >& mipmap_sizes);
     // ------------------------------------------------------------------------
-    bool saveCompressedTexture(std::shared_ptr<video::IImage> texture,
-                              const std::vector<std::pair<core::dimension2du,
-                              unsigned> >& sizes,
-                              const std::string& cache_location);
-    // ------------------------------------------------------------------------
     std::vector<std::pair<core::dimension2du, unsigned> >
                        compressTexture(std::shared_ptr<video::IImage> texture);
     // ------------------------------------------------------------------------
-    bool useTextureCache(const std::string& full_path, std::string* cache_loc);
+    std::string getMaskPath() const;
+    // ------------------------------------------------------------------------
+    uint64_t getFileStamp() const;
     // ------------------------------------------------------------------------
-    std::shared_ptr<video::IImage> getTextureCache(const std::string& path,
-        std::vector<std::pair<core::dimension2du, unsigned> >* sizes);
+    uint64_t getContentHash() const;
 
 public:
     // ------------------------------------------------------------------------
@@ -191,6 +202,10 @@ public:
     unsigned getHeight() const                      { return m_height.load(); }
     // ------------------------------------------------------------------------
     bool load();
+    // ------------------------------------------------------------------------
+    void prepare();
+    // ------------------------------------------------------------------------
+    bool upload();
 
 
 };
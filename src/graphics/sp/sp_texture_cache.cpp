@@ -0,0 +1,428 @@
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2018 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef SERVER_ONLY
+
+#include "graphics/sp/sp_texture_cache.hpp"
+#include "utils/file_utils.hpp"
+#include "utils/log.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef WIN32
+#include "utils/string_utils.hpp"
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    /** Identifies the file format of the archive, change it if the format
+     *  or the texture compression changes. */
+    const char TEXTURE_CACHE_MAGIC[8] = "STKTEX2";
+
+    /** Header of the archive, followed by the index (num_entries times name
+     *  length, name, stamp, hash, number of mipmaps, width, height and size of each
+     *  mipmap and offset of the data in the file) and the mipmap data. */
+    struct TextureCacheHeader
+    {
+        char     m_magic[8];
+        uint32_t m_num_entries;
+        uint32_t m_index_size;
+    };   // TextureCacheHeader
+
+    // ------------------------------------------------------------------------
+    /** Reads a value from the index, returns false if it is truncated. */
+    template<typename T>
+    bool readValue(const uint8_t** p, const uint8_t* end, T* value)
+    {
+        if (end - *p < (ptrdiff_t)sizeof(T))
+            return false;
+        memcpy(value, *p, sizeof(T));
+        *p += sizeof(T);
+        return true;
+    }   // readValue
+
+    // ------------------------------------------------------------------------
+    template<typename T>
+    void writeValue(std::string* out, const T& value)
+    {
+        out->append((const char*)&value, sizeof(T));
+    }   // writeValue
+
+    // ------------------------------------------------------------------------
+    /** Holds an exclusive lock on a lock file while it exists, so that only
+     *  one process at a time merges and rewrites an archive. The lock file
+     *  is never deleted, deleting it would let two processes lock different
+     *  files. If it can't be locked, the archive is still written, and the
+     *  textures of a concurrent save may be lost. */
+    class ArchiveLock
+    {
+#ifdef WIN32
+        HANDLE m_handle;
+#else
+        int m_fd;
+#endif
+    public:
+        ArchiveLock(const std::string& file)
+        {
+#ifdef WIN32
+            m_handle = CreateFileW(StringUtils::utf8ToWide(file).c_str(),
+                                   GENERIC_READ | GENERIC_WRITE,
+                                   FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                                   OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+            OVERLAPPED overlapped = {};
+            if (m_handle != INVALID_HANDLE_VALUE &&
+                !LockFileEx(m_handle, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0,
+                            &overlapped))
+            {
+                CloseHandle(m_handle);
+                m_handle = INVALID_HANDLE_VALUE;
+            }
+            if (m_handle == INVALID_HANDLE_VALUE)
+#else
+            m_fd = open(file.c_str(), O_RDWR | O_CREAT, 0644);
+            if (m_fd != -1 && flock(m_fd, LOCK_EX) != 0)
+            {
+                close(m_fd);
+                m_fd = -1;
+            }
+            if (m_fd == -1)
+#endif
+            {
+                Log::warn("SPTextureCache", "Can't lock '%s'.", file.c_str());
+            }
+        }   // ArchiveLock
+        // --------------------------------------------------------------------
+        ~ArchiveLock()
+        {
+            // Closing the file releases the lock
+#ifdef WIN32
+            if (m_handle != INVALID_HANDLE_VALUE)
+                CloseHandle(m_handle);
+#else
+            if (m_fd != -1)
+                close(m_fd);
+#endif
+        }   // ~ArchiveLock
+    };   // ArchiveLock
+}   // namespace
+
+namespace SP
+{
+// ----------------------------------------------------------------------------
+/** Maps the archive if it exists.
+ *  \param file The archive file, its directory must exist.
+ */
+SPTextureCache::SPTextureCache(const std::string& file)
+              : m_file(file), m_dirty(false)
+{
+    load();
+}   // SPTextureCache
+
+// ----------------------------------------------------------------------------
+/** Saves the textures added since the last save. */
+SPTextureCache::~SPTextureCache()
+{
+    save();
+    unmap(&m_archive);
+}   // ~SPTextureCache
+
+// ----------------------------------------------------------------------------
+/** Maps the archive into memory and reads its index. A missing archive is
+ *  treated as an empty one, a corrupted one is ignored (and replaced by the
+ *  next save()).
+ */
+void SPTextureCache::load()
+{
+    map(m_file, &m_archive);
+    if (m_archive.m_mapping && !readIndex(m_archive, &m_entries))
+    {
+        Log::info("SPTextureCache", "Texture cache '%s' is outdated.",
+                  m_file.c_str());
+        m_entries.clear();
+        unmap(&m_archive);
+    }
+}   // load
+
+// ----------------------------------------------------------------------------
+/** Maps an archive file into memory, leaves it unmapped if it is missing or
+ *  empty.
+ */
+void SPTextureCache::map(const std::string& file, Archive* archive)
+{
+#ifdef WIN32
+    FILE* f = FileUtils::fopenU8Path(file, "rb");
+    if (!f)
+        return;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size > 0)
+    {
+        archive->m_file_data.resize(size);
+        if (fread(archive->m_file_data.data(), 1, size, f) == (size_t)size)
+        {
+            archive->m_mapping = archive->m_file_data.data();
+            archive->m_mapping_size = size;
+        }
+    }
+    fclose(f);
+#else
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd == -1)
+        return;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        void* mapping = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED)
+        {
+            archive->m_mapping = (uint8_t*)mapping;
+            archive->m_mapping_size = st.st_size;
+        }
+    }
+    // The mapping stays valid after closing (or replacing) the file
+    close(fd);
+#endif
+}   // map
+
+// ----------------------------------------------------------------------------
+void SPTextureCache::unmap(Archive* archive)
+{
+#ifdef WIN32
+    archive->m_file_data.clear();
+    archive->m_file_data.shrink_to_fit();
+#else
+    if (archive->m_mapping)
+        munmap(archive->m_mapping, archive->m_mapping_size);
+#endif
+    archive->m_mapping = NULL;
+    archive->m_mapping_size = 0;
+}   // unmap
+
+// ----------------------------------------------------------------------------
+/** Reads the index of a mapped archive into entries pointing into it,
+ *  returns false if the archive has another format or is truncated.
+ */
+bool SPTextureCache::readIndex(const Archive& archive,
+                               std::map<std::string, Entry>* entries)
+{
+    const uint8_t* end = archive.m_mapping + archive.m_mapping_size;
+    const uint8_t* p = archive.m_mapping;
+    TextureCacheHeader header;
+    if (!readValue(&p, end, &header) ||
+        memcmp(header.m_magic, TEXTURE_CACHE_MAGIC,
+               sizeof(header.m_magic)) != 0 ||
+        header.m_index_size > (size_t)(end - p))
+        return false;
+
+    const uint8_t* index_end = p + header.m_index_size;
+    for (uint32_t i = 0; i < header.m_num_entries; i++)
+    {
+        uint32_t name_length, num_mipmaps;
+        uint64_t offset;
+        Entry entry;
+        entry.m_modified = false;
+        if (!readValue(&p, index_end, &name_length) ||
+            name_length > (size_t)(index_end - p))
+            return false;
+        std::string name((const char*)p, name_length);
+        p += name_length;
+        if (!readValue(&p, index_end, &entry.m_stamp) ||
+            !readValue(&p, index_end, &entry.m_hash) ||
+            !readValue(&p, index_end, &num_mipmaps) ||
+            num_mipmaps == 0 ||
+            num_mipmaps > (size_t)(index_end - p) / 12)
+            return false;
+        uint64_t total_size = 0;
+        entry.m_sizes.resize(num_mipmaps);
+        for (auto& s : entry.m_sizes)
+        {
+            readValue(&p, index_end, &s.first.Width);
+            readValue(&p, index_end, &s.first.Height);
+            readValue(&p, index_end, &s.second);
+            total_size += s.second;
+        }
+        if (!readValue(&p, index_end, &offset) ||
+            offset > archive.m_mapping_size ||
+            total_size > archive.m_mapping_size - offset)
+            return false;
+        entry.m_data = archive.m_mapping + offset;
+        (*entries)[name] = std::move(entry);
+    }
+    return true;
+}   // readIndex
+
+// ----------------------------------------------------------------------------
+/** Returns the compressed mipmaps of a texture, or NULL if the archive
+ *  does not contain it or it was compressed from another content. The data
+ *  stays valid until the next save().
+ *  \param name Name of the texture.
+ *  \param stamp File stamp of the texture (and its mask).
+ *  \param hash Hash of the content of the texture (and its mask), or 0 to
+ *         only compare the stamp. If the content matches, the stamp of the
+ *         texture is updated.
+ *  \param sizes Set to the size of each mipmap.
+ */
+const uint8_t* SPTextureCache::find(const std::string& name, uint64_t stamp,
+                                    uint64_t hash, MipmapSizes* sizes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(name);
+    if (it == m_entries.end())
+        return NULL;
+    if (it->second.m_stamp != stamp)
+    {
+        if (hash == 0 || it->second.m_hash != hash)
+            return NULL;
+        it->second.m_stamp = stamp;
+        it->second.m_modified = true;
+        m_dirty = true;
+    }
+    *sizes = it->second.m_sizes;
+    return it->second.m_data;
+}   // find
+
+// ----------------------------------------------------------------------------
+/** Adds (or replaces) the compressed mipmaps of a texture. They are copied,
+ *  and written to the archive by the next save().
+ *  \param name Name of the texture.
+ *  \param stamp File stamp of the texture (and its mask).
+ *  \param hash Hash of the content of the texture (and its mask).
+ *  \param sizes Size of each mipmap.
+ *  \param data The mipmaps, one after the other.
+ */
+void SPTextureCache::add(const std::string& name, uint64_t stamp,
+                         uint64_t hash, const MipmapSizes& sizes,
+                         const uint8_t* data)
+{
+    size_t total_size = 0;
+    for (auto& s : sizes)
+        total_size += s.second;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry& entry = m_entries[name];
+    entry.m_stamp = stamp;
+    entry.m_hash = hash;
+    entry.m_sizes = sizes;
+    entry.m_payload.assign(data, data + total_size);
+    entry.m_data = entry.m_payload.data();
+    entry.m_modified = true;
+    m_dirty = true;
+}   // add
+
+// ----------------------------------------------------------------------------
+/** Rewrites the archive if textures were added, and maps it again. Under a
+ *  lock file, the archive is read again and the textures other processes
+ *  saved since it was mapped are kept, unless this process added (or
+ *  re-stamped) the same texture. It is replaced atomically (see
+ *  FileUtils::writeFileAtomic). Invalidates all data returned by find(), so
+ *  it must not be called while textures are loaded.
+ */
+void SPTextureCache::save()
+{
+    if (!m_dirty)
+        return;
+    m_dirty = false;
+
+    ArchiveLock lock(m_file + ".lock");
+    Archive disk_archive;
+    std::map<std::string, Entry> disk_entries;
+    map(m_file, &disk_archive);
+    if (disk_archive.m_mapping &&
+        !readIndex(disk_archive, &disk_entries))
+        disk_entries.clear();
+
+    std::map<std::string, const Entry*> entries;
+    for (auto& p : m_entries)
+        entries[p.first] = &p.second;
+    for (auto& p : disk_entries)
+    {
+        auto it = m_entries.find(p.first);
+        if (it == m_entries.end() || !it->second.m_modified)
+            entries[p.first] = &p.second;
+    }
+
+    std::string index;
+    // The mipmap data starts after the header and the index
+    uint64_t offset = sizeof(TextureCacheHeader);
+    for (auto& p : entries)
+    {
+        offset += 4 + p.first.size() + 8 + 8 + 4 +
+            12 * p.second->m_sizes.size() + 8;
+    }
+    for (auto& p : entries)
+    {
+        writeValue(&index, (uint32_t)p.first.size());
+        index += p.first;
+        writeValue(&index, p.second->m_stamp);
+        writeValue(&index, p.second->m_hash);
+        writeValue(&index, (uint32_t)p.second->m_sizes.size());
+        uint64_t total_size = 0;
+        for (auto& s : p.second->m_sizes)
+        {
+            writeValue(&index, s.first.Width);
+            writeValue(&index, s.first.Height);
+            writeValue(&index, s.second);
+            total_size += s.second;
+        }
+        writeValue(&index, offset);
+        offset += total_size;
+    }
+
+    TextureCacheHeader header;
+    memcpy(header.m_magic, TEXTURE_CACHE_MAGIC, sizeof(header.m_magic));
+    header.m_num_entries = (uint32_t)entries.size();
+    header.m_index_size  = (uint32_t)index.size();
+    bool success = FileUtils::writeFileAtomic(m_file, [&](FILE* f)
+    {
+        if (fwrite(&header, sizeof(header), 1, f) != 1 ||
+            fwrite(index.data(), 1, index.size(), f) != index.size())
+            return false;
+        for (auto& p : entries)
+        {
+            size_t total_size = 0;
+            for (auto& s : p.second->m_sizes)
+                total_size += s.second;
+            if (fwrite(p.second->m_data, 1, total_size, f) != total_size)
+                return false;
+        }
+        return true;
+    });
+    unmap(&disk_archive);
+    if (!success)
+    {
+        Log::warn("SPTextureCache", "Can't write texture cache '%s'.",
+                  m_file.c_str());
+        return;
+    }
+
+    // Drop the copies of the added textures, they are in the new mapping
+    m_entries.clear();
+    unmap(&m_archive);
+    load();
+}   // save
+
+}
+
+#endif
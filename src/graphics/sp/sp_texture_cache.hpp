@@ -0,0 +1,124 @@
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2018 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef HEADER_SP_TEXTURE_CACHE_HPP
+#define HEADER_SP_TEXTURE_CACHE_HPP
+
+#ifndef SERVER_ONLY
+
+#include "utils/no_copy.hpp"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dimension2d.h>
+
+using namespace irr;
+
+namespace SP
+{
+
+/**
+ * \brief The compressed textures of one cache directory, packed into a
+ *  single archive file.
+ *  The archive holds an index (name, file stamp, content hash and mipmap
+ *  sizes of each texture) followed by the compressed mipmaps. Textures are
+ *  found by their file stamp (path, size and modification time), the
+ *  content hash is only compared if the stamp changed. It is mapped into memory
+ *  once, and textures are uploaded directly from the mapping. Textures
+ *  compressed since then are kept in memory until save() rewrites the
+ *  archive. save() merges the textures other processes saved in the
+ *  meantime, under a lock file next to the archive.
+ *  find() and add() can be called from worker threads.
+ * \ingroup sp
+ */
+class SPTextureCache : public NoCopy
+{
+public:
+    typedef std::vector<std::pair<core::dimension2du, unsigned> > MipmapSizes;
+
+private:
+    struct Entry
+    {
+        /** Hash of path, size and modification time of the texture (and its
+         *  mask) file. */
+        uint64_t             m_stamp;
+        /** Hash of the content of the texture (and its mask) file. */
+        uint64_t             m_hash;
+        MipmapSizes          m_sizes;
+        /** The compressed mipmaps, in the mapping or in m_payload. */
+        const uint8_t       *m_data;
+        /** Owns the compressed mipmaps of textures added since the archive
+         *  was mapped. */
+        std::vector<uint8_t> m_payload;
+        /** True if this process added the texture or changed its stamp,
+         *  it is preferred over the entry of the on-disk archive in save(). */
+        bool                 m_modified;
+    };   // Entry
+
+    /** An archive file in memory: mapped, or read on windows. */
+    struct Archive
+    {
+        uint8_t *m_mapping;
+        size_t m_mapping_size;
+#ifdef WIN32
+        std::vector<uint8_t> m_file_data;
+#endif
+        Archive() : m_mapping(NULL), m_mapping_size(0) {}
+    };   // Archive
+
+    std::string m_file;
+
+    std::map<std::string, Entry> m_entries;
+
+    std::mutex m_mutex;
+
+    /** The archive the entries (without payload) point into. */
+    Archive m_archive;
+
+    /** True if textures were added (or stamps changed) since the archive
+     *  was mapped. */
+    bool m_dirty;
+
+    void load();
+    static void map(const std::string& file, Archive* archive);
+    static void unmap(Archive* archive);
+    static bool readIndex(const Archive& archive,
+                          std::map<std::string, Entry>* entries);
+
+public:
+    SPTextureCache(const std::string& file);
+    ~SPTextureCache();
+    // ------------------------------------------------------------------------
+    const uint8_t* find(const std::string& name, uint64_t stamp,
+                        uint64_t hash, MipmapSizes* sizes);
+    // ------------------------------------------------------------------------
+    void add(const std::string& name, uint64_t stamp, uint64_t hash,
+             const MipmapSizes& sizes, const uint8_t* data);
+    // ------------------------------------------------------------------------
+    void save();
+};   // SPTextureCache
+
+}
+
+#endif
+
+#endif
@@ -20,10 +20,14 @@
 #include "graphics/sp/sp_texture_manager.hpp"
 #include "graphics/sp/sp_base.hpp"
 #include "graphics/sp/sp_texture.hpp"
+#include "graphics/sp/sp_texture_cache.hpp"
 #include "graphics/central_settings.hpp"
 #include "graphics/irr_driver.hpp"
+#include "io/file_manager.hpp"
+#include "utils/profiler.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/vs.hpp"
+#include "utils/worker_pool.hpp"
 
 #include <string>
 
@@ -31,7 +35,7 @@ namespace SP
 {
 SPTextureManager* SPTextureManager::m_sptm = NULL;
 // ----------------------------------------------------------------------------
-SPTextureManager::SPTextureManager()
+SPTextureManager::SPTextureManager() : m_batch_depth(0)
 {
     m_textures["unicolor_white"] = SPTexture::getWhiteTexture();
     m_textures[""] = SPTexture::getTransparentTexture();
@@ -62,11 +66,90 @@ std::shared_ptr<SPTexture> SPTextureManager::getTexture(const std::string& p,
     }
     std::shared_ptr<SPTexture> t =
         std::make_shared<SPTexture>(p, m, undo_srgb, cid);
-    t->load();
+    if (m_batch_depth > 0)
+        m_pending_textures.push_back(t);
+    else
+        t->load();
     m_textures[p] = t;
     return t;
 }   // getTexture
 
+// ----------------------------------------------------------------------------
+SPTextureManager::ScopedBatch::ScopedBatch() : m_active(CVS->isGLSL())
+{
+    if (m_active)
+        SPTextureManager::get()->beginBatch();
+}   // ScopedBatch
+
+// ----------------------------------------------------------------------------
+SPTextureManager::ScopedBatch::~ScopedBatch()
+{
+    if (m_active)
+        SPTextureManager::get()->endBatch();
+}   // ~ScopedBatch
+
+// ----------------------------------------------------------------------------
+/** Closes a batch, if it is the outermost one all textures requested since
+ *  the first beginBatch() are loaded.
+ */
+void SPTextureManager::endBatch()
+{
+    assert(m_batch_depth > 0);
+    m_batch_depth--;
+    if (m_batch_depth == 0)
+        loadPendingTextures();
+}   // endBatch
+
+// ----------------------------------------------------------------------------
+/** Loads all pending textures. Decoding, mipmap generation and compression
+ *  run in parallel on the worker pool (if there is one), then the textures
+ *  are uploaded on this thread in the order they were requested.
+ */
+void SPTextureManager::loadPendingTextures()
+{
+    if (m_pending_textures.empty())
+        return;
+    PROFILER_PUSH_CPU_MARKER("SPTextureManager::loadPendingTextures", 0, 0, 0);
+    std::function<void(unsigned int)> prepare = [this](unsigned int i)
+    {
+        m_pending_textures[i]->prepare();
+    };
+    if (WorkerPool::get())
+    {
+        WorkerPool::get()->parallelFor(
+            (unsigned int)m_pending_textures.size(), prepare);
+    }
+    else
+    {
+        for (unsigned int i = 0; i < m_pending_textures.size(); i++)
+            prepare(i);
+    }
+    for (std::shared_ptr<SPTexture> &t : m_pending_textures)
+        t->upload();
+    m_pending_textures.clear();
+    // All textures are uploaded, so no texture uses the old archives anymore
+    for (auto& p : m_texture_caches)
+        p.second->save();
+    PROFILER_POP_CPU_MARKER();
+}   // loadPendingTextures
+
+// ----------------------------------------------------------------------------
+/** Returns the texture cache archive of a cache directory, the archive is
+ *  mapped (and the directory created) when it is first used.
+ *  \param dir The directory for the compressed textures of a track or
+ *         kart.
+ */
+SPTextureCache* SPTextureManager::getTextureCache(const std::string& dir)
+{
+    std::unique_ptr<SPTextureCache>& cache = m_texture_caches[dir];
+    if (!cache)
+    {
+        file_manager->checkAndCreateDirectoryP(dir);
+        cache.reset(new SPTextureCache(dir + "/textures.sptp"));
+    }
+    return cache.get();
+}   // getTextureCache
+
 // ----------------------------------------------------------------------------
 void SPTextureManager::removeUnusedTextures()
 {
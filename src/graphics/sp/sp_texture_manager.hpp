@@ -32,6 +32,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "irrString.h"
 
@@ -40,14 +41,38 @@ class Material;
 namespace SP
 {
 class SPTexture;
+class SPTextureCache;
 
 class SPTextureManager : public NoCopy
 {
+public:
+    /** Opens a batch for its lifetime (also if loading throws), if the SP
+     *  renderer is used. */
+    class ScopedBatch : public NoCopy
+    {
+    private:
+        bool m_active;
+    public:
+        ScopedBatch();
+        ~ScopedBatch();
+    };   // ScopedBatch
+
 private:
     static SPTextureManager* m_sptm;
 
     std::map<std::string, std::shared_ptr<SPTexture> > m_textures;
 
+    /** Textures requested while a batch is open, in the order of the
+     *  requests. They are loaded when the batch is closed. */
+    std::vector<std::shared_ptr<SPTexture> > m_pending_textures;
+
+    unsigned int m_batch_depth;
+
+    /** The texture cache archive of each cache directory. */
+    std::map<std::string, std::unique_ptr<SPTextureCache> > m_texture_caches;
+
+    void loadPendingTextures();
+
 public:
     // ------------------------------------------------------------------------
     static SPTextureManager* get()
@@ -78,6 +103,15 @@ public:
     void dumpAllTextures();
     // ------------------------------------------------------------------------
     irr::core::stringw reloadTexture(const irr::core::stringw& name);
+    // ------------------------------------------------------------------------
+    /** Until the matching endBatch(), textures are only created when they
+     *  are requested, and loaded together when the batch is closed. Batches
+     *  can be nested, only the outermost one loads the textures. */
+    void beginBatch()                                    { m_batch_depth++; }
+    // ------------------------------------------------------------------------
+    void endBatch();
+    // ------------------------------------------------------------------------
+    SPTextureCache* getTextureCache(const std::string& cache_directory);
 
 };
 
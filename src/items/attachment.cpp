@@ -40,6 +40,7 @@
 #include "tracks/track.hpp"
 #include "utils/constants.hpp"
 #include "utils/objecttype.h"
+#include "utils/snapshot.hpp"
 
 #include "irrMath.h"
 #include <IAnimatedMeshSceneNode.h>
@@ -162,6 +163,43 @@ void Attachment::clear()
     m_initial_speed = 0;
 }   // clear
 
+// -----------------------------------------------------------------------------
+/** Saves the attachment into a snapshot. The internal state of a swatter
+ *  plugin is not saved, it is recreated on restore.
+ */
+void Attachment::saveState(Snapshot *s) const
+{
+    s->add(m_type);
+    s->add(m_ticks_left);
+    s->add(m_initial_speed);
+    s->add(m_scaling_end_ticks);
+    s->add<int>(m_previous_owner ? m_previous_owner->getWorldKartId() : -1);
+}   // saveState
+
+// -----------------------------------------------------------------------------
+/** Restores an attachment saved with saveState. */
+void Attachment::restoreState(Snapshot *s)
+{
+    AttachmentType type = s->get<AttachmentType>();
+    int16_t ticks_left = s->get<int16_t>();
+    int16_t initial_speed = s->get<int16_t>();
+    int scaling_end_ticks = s->get<int>();
+    int previous_owner = s->get<int>();
+
+    if (type != m_type)
+    {
+        if (type == ATTACH_NOTHING)
+            clear();
+        else
+            set(type, ticks_left, NULL, /*set_by_rewind_parachute*/true);
+    }
+    m_ticks_left = ticks_left;
+    m_initial_speed = initial_speed;
+    m_scaling_end_ticks = scaling_end_ticks;
+    m_previous_owner = previous_owner >= 0 ?
+        World::getWorld()->getKart(previous_owner) : NULL;
+}   // restoreState
+
 // -----------------------------------------------------------------------------
 /** Selects the new attachment. In order to simplify synchronisation with the
  *  server, the new item is based on the current world time. 
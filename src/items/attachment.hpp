@@ -32,6 +32,7 @@ namespace irr
 
 class AbstractKart;
 class ItemState;
+class Snapshot;
 
 /** This objects is permanently available in a kart and stores information
  *  about addons. If a kart has no attachment, this object will have the
@@ -115,6 +116,8 @@ public:
     void  set (AttachmentType type, int ticks,
                AbstractKart *previous_kart=NULL,
                bool set_by_rewind_parachute = false);
+    void  saveState(Snapshot *s) const;
+    void  restoreState(Snapshot *s);
 
     // ------------------------------------------------------------------------
     /** Sets the type of the attachment, but keeps the old time left value. */
@@ -23,7 +23,9 @@
 
 #include "io/xml_node.hpp"
 #include "karts/abstract_kart.hpp"
+#include "modes/world.hpp"
 #include "utils/constants.hpp"
+#include "utils/snapshot.hpp"
 
 #include "utils/log.hpp" //TODO: remove after debugging is done
 
@@ -167,3 +169,24 @@ void Cake::onFireFlyable()
     m_body->clearForces();
     m_body->applyTorque(btVector3(5.0f, -3.0f, 7.0f));
 }   // onFireFlyable
+
+// ----------------------------------------------------------------------------
+/** Saves the velocity and the target of the cake. The target is stored as
+ *  its world kart id, or -1 if the cake is not homing.
+ */
+void Cake::saveState(Snapshot *s) const
+{
+    Flyable::saveState(s);
+    s->add(m_initial_velocity);
+    s->add<int>(m_target ?
+        (int)static_cast<AbstractKart*>(m_target)->getWorldKartId() : -1);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+void Cake::restoreState(Snapshot *s)
+{
+    Flyable::restoreState(s);
+    s->get(&m_initial_velocity);
+    int target = s->get<int>();
+    m_target = target < 0 ? NULL : World::getWorld()->getKart(target);
+}   // restoreState
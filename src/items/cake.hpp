@@ -74,6 +74,10 @@ public:
                                                     { m_initial_velocity = v; }
     // ------------------------------------------------------------------------
     virtual void onFireFlyable() OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void saveState(Snapshot *s) const OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void restoreState(Snapshot *s) OVERRIDE;
 };   // Cake
 
 #endif
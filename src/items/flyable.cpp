@@ -46,6 +46,7 @@
 #include "utils/vs.hpp"
 #include "utils/objecttype.h"
 #include "utils/mini_glm.hpp"
+#include "utils/snapshot.hpp"
 
 #include <typeinfo>
 
@@ -678,4 +679,52 @@ void Flyable::onDeleteFlyable()
     moveToInfinity();
 }   // onDeleteFlyable
 
+// ----------------------------------------------------------------------------
+/** Saves the physical state and the flight parameters (lifespan, heights,
+ *  speed) of this flyable into a snapshot. Subclasses append their own
+ *  state after this. */
+void Flyable::saveState(Snapshot *s) const
+{
+    Moveable::saveState(s);
+    s->add(m_has_hit_something);
+    s->add(m_owner_has_temporary_immunity);
+    s->add(m_created_ticks);
+    s->add(m_ticks_since_thrown);
+    s->add(m_speed);
+    s->add(m_max_height);
+    s->add(m_min_height);
+    s->add(m_average_height);
+    s->add(m_force_updown);
+    s->add(m_max_lifespan);
+    s->add(m_adjust_up_velocity);
+    s->add(m_do_terrain_info);
+    s->add(m_position_offset);
+    s->add(m_has_server_state);
+    s->add(m_deleted_once);
+    s->add(m_last_deleted_ticks);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state saved with saveState. */
+void Flyable::restoreState(Snapshot *s)
+{
+    Moveable::restoreState(s);
+    s->get(&m_has_hit_something);
+    s->get(&m_owner_has_temporary_immunity);
+    s->get(&m_created_ticks);
+    s->get(&m_ticks_since_thrown);
+    s->get(&m_speed);
+    s->get(&m_max_height);
+    s->get(&m_min_height);
+    s->get(&m_average_height);
+    s->get(&m_force_updown);
+    s->get(&m_max_lifespan);
+    s->get(&m_adjust_up_velocity);
+    s->get(&m_do_terrain_info);
+    s->get(&m_position_offset);
+    s->get(&m_has_server_state);
+    s->get(&m_deleted_once);
+    s->get(&m_last_deleted_ticks);
+}   // restoreState
+
 /* EOF */
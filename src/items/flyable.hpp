@@ -253,6 +253,10 @@ public:
     // ------------------------------------------------------------------------
     virtual void onDeleteFlyable();
     // ------------------------------------------------------------------------
+    virtual void saveState(Snapshot *s) const OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void restoreState(Snapshot *s) OVERRIDE;
+    // ------------------------------------------------------------------------
     void setCreatedTicks(int ticks)                { m_created_ticks = ticks; }
     
     void setObjectId(uint32_t id);
@@ -30,6 +30,7 @@
 #include "tracks/arena_graph.hpp"
 #include "tracks/arena_node.hpp"
 #include "tracks/track.hpp"
+#include "utils/snapshot.hpp"
 #include "utils/string_utils.hpp"
 
 #include <IMesh.h>
@@ -47,6 +48,9 @@ std::vector<video::SColorf>  ItemManager::m_glow_color;
 bool                         ItemManager::m_disable_item_collection = false;
 std::shared_ptr<ItemManager> ItemManager::m_item_manager;
 std::mt19937                 ItemManager::m_random_engine;
+// Item::hitKart halves the distance along the item's normal, so a kart can
+// hit an item from up to 2*sqrt(m_distance_2) (about 2.2) away.
+const float                  ItemManager::ITEM_CELL_SIZE = 4.0f;
 uint32_t                     ItemManager::m_random_seed = 0;
 
 //-----------------------------------------------------------------------------
@@ -244,10 +248,20 @@ unsigned int ItemManager::insertItem(Item *item)
 
 //-----------------------------------------------------------------------------
 /** Insert into the appropriate quad list, if there is a quad list
- *  (i.e. race mode has a quad graph).
+ *  (i.e. race mode has a quad graph), and into the grid cell of the item.
  */
 void ItemManager::insertItemInQuad(Item *item)
 {
+    const Vec3 &xyz = item->getXYZ();
+    const uint64_t key = getCellKey(getCellIndex(xyz.getX()),
+                                    getCellIndex(xyz.getZ()));
+    AllItemTypes &cell = m_items_in_cells[key];
+    // Keep the cell sorted by item id, see checkItemHit
+    cell.insert(std::upper_bound(cell.begin(), cell.end(), item,
+                                 [](const ItemState *a, const ItemState *b)
+                                 { return a->getItemId() < b->getItemId(); }),
+                item);
+
     if(m_items_in_quads)
     {
         int graph_node = item->getGraphNode();
@@ -376,14 +390,10 @@ void ItemManager::collectedItem(ItemState *item, AbstractKart *kart)
  */
 void  ItemManager::checkItemHit(AbstractKart* kart)
 {
-    // We could use m_items_in_quads to to check for item hits: take the quad
-    // of the graph node of the kart, and only check items in that quad. But
-    // then we also need to check for any adjacent quads (since an item just
-    // on the order of one quad might get hit from an adjacent quad). Then
-    // it is possible that a quad is that short that we need to test adjacent
-    // of adjacent quads. And check for items outside of the track.
-    // Since at this stace item detection is by far not a bottle neck,
-    // the original, simple and stable algorithm is left in place.
+    // Using m_items_in_quads would require to check adjacent quads (and
+    // adjacent of adjacent quads for short quads) and all items outside of
+    // the track. Instead a uniform grid is used: only the items in the 3x3
+    // cells around the kart can be close enough to be hit.
 
     /** Disable item collection detection for debug purposes. */
     if(m_disable_item_collection) return;
@@ -391,8 +401,33 @@ void  ItemManager::checkItemHit(AbstractKart* kart)
     // Spare tire karts don't collect items
     if ( dynamic_cast<SpareTireAI*>(kart->getController()) ) return;
 
-    for(AllItemTypes::iterator i =m_all_items.begin();
-                               i!=m_all_items.end();  i++)
+    const int cx = getCellIndex(kart->getXYZ().getX());
+    const int cz = getCellIndex(kart->getXYZ().getZ());
+    m_close_items.clear();
+    int num_cells = 0;
+    for (int z = cz - 1; z <= cz + 1; z++)
+    {
+        for (int x = cx - 1; x <= cx + 1; x++)
+        {
+            auto cell = m_items_in_cells.find(getCellKey(x, z));
+            if (cell == m_items_in_cells.end())
+                continue;
+            m_close_items.insert(m_close_items.end(), cell->second.begin(),
+                                 cell->second.end());
+            num_cells++;
+        }
+    }
+    // Test the items in the same order as m_all_items, in case that
+    // several items are hit at the same time. Each cell is already sorted.
+    if (num_cells > 1)
+    {
+        std::sort(m_close_items.begin(), m_close_items.end(),
+                  [](const ItemState *a, const ItemState *b)
+                  { return a->getItemId() < b->getItemId(); });
+    }
+
+    for(AllItemTypes::iterator i =m_close_items.begin();
+                               i!=m_close_items.end();  i++)
     {
         // Ignore items that have been collected or are not available atm
         if ((!*i) || !(*i)->isAvailable() || (*i)->isUsedUp()) continue;
@@ -412,7 +447,7 @@ void  ItemManager::checkItemHit(AbstractKart* kart)
         {
             collectedItem(*i, kart);
         }   // if hit
-    }   // for m_all_items
+    }   // for close_items
 }   // checkItemHit
 
 //-----------------------------------------------------------------------------
@@ -459,6 +494,98 @@ void ItemManager::reset()
     m_switch_ticks = -1;
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the state of all items into a snapshot. Besides the item state,
+ *  the location and owner of each item is stored, so that items which were
+ *  removed or dropped after the snapshot was taken can be recreated
+ *  respectively deleted in restoreState.
+ */
+void ItemManager::saveState(Snapshot *s) const
+{
+    s->add(m_switch_ticks);
+    s->add(m_random_engine);
+    s->add<uint32_t>((uint32_t)m_all_items.size());
+    for (const ItemState *item : m_all_items)
+    {
+        s->add<bool>(item != NULL);
+        if (!item)
+            continue;
+        const AbstractKart *owner = item->getPreviousOwner();
+        s->add<int>(owner ? owner->getWorldKartId() : -1);
+        s->add(item->m_xyz);
+        s->add(item->m_original_rotation);
+        s->add(item->m_type);
+        s->add(item->m_original_type);
+        s->add(item->m_ticks_till_return);
+        s->add(item->m_deactive_ticks);
+        s->add(item->m_used_up_counter);
+    }
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state of all items saved with saveState. Each item keeps its
+ *  index in m_all_items, which is used e.g. for the random powerup.
+ */
+void ItemManager::restoreState(Snapshot *s)
+{
+    s->get(&m_switch_ticks);
+    s->get(&m_random_engine);
+    unsigned int n = s->get<uint32_t>();
+    for (unsigned int i = n; i < m_all_items.size(); i++)
+    {
+        if (m_all_items[i])
+            deleteItem(m_all_items[i]);
+    }
+    m_all_items.resize(n, NULL);
+
+    for (unsigned int i = 0; i < n; i++)
+    {
+        ItemState *item = m_all_items[i];
+        if (!s->get<bool>())
+        {
+            if (item)
+                deleteItem(item);
+            continue;
+        }
+        int owner_id = s->get<int>();
+        const AbstractKart *owner =
+            owner_id >= 0 ? World::getWorld()->getKart(owner_id) : NULL;
+        Vec3 xyz = s->get<Vec3>();
+        btQuaternion rotation = s->get<btQuaternion>();
+        ItemState::ItemType type = s->get<ItemState::ItemType>();
+
+        if (item && (item->getXYZ() != xyz ||
+                     item->getPreviousOwner() != owner))
+        {
+            deleteItem(item);
+            item = NULL;
+        }
+        if (!item)
+        {
+            // The item was removed (e.g. a collected bubble gum) or replaced
+            // after the snapshot was taken: recreate it in the same slot.
+            ItemState::ItemType mesh_type = type;
+            if (type == ItemState::ITEM_BUBBLEGUM && owner &&
+                owner->getIdent() == "nolok")
+                mesh_type = ItemState::ITEM_BUBBLEGUM_NOLOK;
+            Item *new_item = new Item(type, xyz,
+                                      quatRotate(rotation, Vec3(0, 1, 0)),
+                                      m_item_mesh[mesh_type],
+                                      m_item_lowres_mesh[mesh_type], owner);
+            new_item->m_original_rotation = rotation;
+            m_all_items[i] = new_item;
+            new_item->setItemId(i);
+            insertItemInQuad(new_item);
+            item = new_item;
+        }
+        item->m_type = type;
+        s->get(&item->m_original_type);
+        s->get(&item->m_ticks_till_return);
+        s->get(&item->m_deactive_ticks);
+        s->get(&item->m_used_up_counter);
+    }
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Updates all items, and handles switching items back if the switch time
  *  is over.
@@ -523,11 +650,22 @@ void ItemManager::deleteItem(ItemState *item)
 }   // delete item
 
 //-----------------------------------------------------------------------------
-/** Removes an items from the items-in-quad list only
+/** Removes an items from the items-in-quad list and the item grid only
  *  \param The item to delete.
  */
 void ItemManager::deleteItemInQuad(ItemState* item)
 {
+    const Vec3 &xyz = item->getXYZ();
+    auto cell = m_items_in_cells.find(getCellKey(getCellIndex(xyz.getX()),
+                                                 getCellIndex(xyz.getZ())));
+    assert(cell != m_items_in_cells.end());
+    AllItemTypes::iterator in_cell = std::find(cell->second.begin(),
+                                               cell->second.end(), item);
+    assert(in_cell != cell->second.end());
+    cell->second.erase(in_cell);
+    if (cell->second.empty())
+        m_items_in_cells.erase(cell);
+
     if(m_items_in_quads)
     {
         int sector = item->getGraphNode();
@@ -31,13 +31,17 @@
 #include <assert.h>
 #include <algorithm>
 
+#include <cmath>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <random>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class Kart;
+class Snapshot;
 class STKPeer;
 
 /**
@@ -121,6 +125,19 @@ private:
      *  field is undefined if no Graph exist, e.g. arena without navmesh. */
     std::vector< AllItemTypes > *m_items_in_quads;
 
+    /** Size of a cell of m_items_in_cells. Must be at least the largest
+     *  distance at which a kart can hit an item (see Item::hitKart). */
+    static const float ITEM_CELL_SIZE;
+
+    /** A uniform grid in the x/z plane, which stores the items in each
+     *  cell. Used by checkItemHit to only test the items close to a kart.
+     *  Unlike m_items_in_quads it also exists in arenas without navmesh. */
+    std::unordered_map<uint64_t, AllItemTypes> m_items_in_cells;
+
+    /** The items close to a kart, reused by each checkItemHit call to avoid
+     *  an allocation per kart and frame. */
+    AllItemTypes m_close_items;
+
     /** Stores all item models. */
     static std::vector<scene::IMesh *> m_item_mesh;
 
@@ -138,6 +155,18 @@ protected:
     void setSwitchItems(const std::vector<int> &switch_items);
     void insertItemInQuad(Item *item);
     void deleteItemInQuad(ItemState *item);
+    // ------------------------------------------------------------------------
+    /** Returns the key of the cell in m_items_in_cells with the given
+     *  x/z cell coordinates. */
+    static uint64_t getCellKey(int x, int z)
+    {
+        return ((uint64_t)(uint32_t)x << 32) | (uint32_t)z;
+    }   // getCellKey
+    // ------------------------------------------------------------------------
+    static int getCellIndex(float x)
+    {
+        return (int)floorf(x / ITEM_CELL_SIZE);
+    }   // getCellIndex
              ItemManager();
 public:
     virtual ~ItemManager();
@@ -152,6 +181,8 @@ public:
     void           updateGraphics  (float dt);
     void           checkItemHit    (AbstractKart* kart);
     void           reset           ();
+    void           saveState       (Snapshot *s) const;
+    void           restoreState    (Snapshot *s);
     virtual void   collectedItem   (ItemState *item, AbstractKart *kart);
     virtual void   switchItems     ();
     bool           randomItemsForArena(const AlignedArray<btTransform>& pos);
@@ -34,6 +34,7 @@
 #include "physics/physics.hpp"
 #include "tracks/track.hpp"
 #include "utils/constants.hpp"
+#include "utils/snapshot.hpp"
 #include "utils/string_utils.hpp"
 
 // -----------------------------------------------------------------------------
@@ -250,3 +251,41 @@ void Plunger::onDeleteFlyable()
     if (m_rubber_band)
         m_rubber_band->remove();
 }   // onDeleteFlyable
+
+// ----------------------------------------------------------------------------
+/** Saves the plunger and, if it has one, its rubber band. */
+void Plunger::saveState(Snapshot *s) const
+{
+    Flyable::saveState(s);
+    s->add(m_keep_alive);
+    s->add(m_initial_velocity);
+    s->add(m_reverse_mode);
+    s->add(m_moved_to_infinity);
+    s->add(m_rubber_band != NULL);
+    if (m_rubber_band)
+        m_rubber_band->saveState(s);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state saved with saveState. The rubber band is created or
+ *  removed to match the snapshot, since onFireFlyable decides this from the
+ *  current controls of the owner. */
+void Plunger::restoreState(Snapshot *s)
+{
+    Flyable::restoreState(s);
+    s->get(&m_keep_alive);
+    s->get(&m_initial_velocity);
+    s->get(&m_reverse_mode);
+    s->get(&m_moved_to_infinity);
+    if (s->get<bool>())
+    {
+        if (!m_rubber_band)
+            m_rubber_band = new RubberBand(this, m_owner);
+        m_rubber_band->restoreState(s);
+    }
+    else if (m_rubber_band)
+    {
+        delete m_rubber_band;
+        m_rubber_band = NULL;
+    }
+}   // restoreState
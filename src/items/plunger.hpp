@@ -70,6 +70,10 @@ public:
     virtual void onFireFlyable() OVERRIDE;
     // ------------------------------------------------------------------------
     virtual void onDeleteFlyable() OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void saveState(Snapshot *s) const OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void restoreState(Snapshot *s) OVERRIDE;
 
 };   // Plunger
 
@@ -30,6 +30,7 @@
 
 #include "physics/triangle_mesh.hpp"
 #include "tracks/track.hpp"
+#include "utils/snapshot.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/log.hpp" //TODO: remove after debugging is done
 
@@ -63,6 +64,22 @@ void Powerup::reset()
     set( (PowerupManager::PowerupType)type, number );
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the collected powerup into a snapshot. */
+void Powerup::saveState(Snapshot *s) const
+{
+    s->add(m_type);
+    s->add(m_number);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the collected powerup saved with saveState. */
+void Powerup::restoreState(Snapshot *s)
+{
+    s->get(&m_type);
+    s->get(&m_number);
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 void Powerup::update(int ticks)
 {
@@ -30,6 +30,7 @@
 #include "karts/controller/controller.hpp"
 #include "modes/world.hpp"
 
+#include "utils/snapshot.hpp"
 #include "utils/string_utils.hpp"
 
 #include <typeinfo>
@@ -61,6 +62,40 @@ void ProjectileManager::cleanup()
     m_active_hit_effects.clear();
 }   // cleanup
 
+//-----------------------------------------------------------------------------
+/** Saves all active projectiles into a snapshot. */
+void ProjectileManager::saveState(Snapshot *s) const
+{
+    s->add<uint32_t>((uint32_t)m_active_projectiles.size());
+    for (auto &p : m_active_projectiles)
+    {
+        s->add(p->getType());
+        s->add<int>(p->getOwner()->getWorldKartId());
+        p->saveState(s);
+    }
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Replaces all active projectiles with the ones saved with saveState. Each
+ *  projectile is fired again by its owner to create its physical body, and
+ *  then all of its state, including the type specific state (e.g. the
+ *  target of a rubber ball), is overwritten from the snapshot. A projectile
+ *  that was flying through a cannon is restored without its animation.
+ */
+void ProjectileManager::restoreState(Snapshot *s)
+{
+    cleanup();
+    unsigned int n = s->get<uint32_t>();
+    for (unsigned int i = 0; i < n; i++)
+    {
+        PowerupManager::PowerupType type =
+            s->get<PowerupManager::PowerupType>();
+        AbstractKart *owner = World::getWorld()->getKart(s->get<int>());
+        std::shared_ptr<Flyable> f = newProjectile(owner, type);
+        f->restoreState(s);
+    }
+}   // restoreState
+
 // -----------------------------------------------------------------------------
 /** Called once per rendered frame. It is used to only update any graphical
  *  effects, and calls updateGraphics in any flyable objects.
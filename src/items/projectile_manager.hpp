@@ -36,6 +36,7 @@ namespace irr
 class AbstractKart;
 class Flyable;
 class HitEffect;
+class Snapshot;
 class Track;
 class Vec3;
 
@@ -62,6 +63,8 @@ public:
     void             update           (int ticks);
     void             updateGraphics   (float dt);
     void             removeTextures   ();
+    void             saveState        (Snapshot *s) const;
+    void             restoreState     (Snapshot *s);
     bool             projectileIsClose(const AbstractKart * const kart,
                                        float radius);
 
@@ -76,6 +79,10 @@ public:
     // ------------------------------------------------------------------------
     std::shared_ptr<Flyable> newProjectile(AbstractKart *kart,
                                            PowerupManager::PowerupType type);
+    // ------------------------------------------------------------------------
+    /** Returns all projectiles currently moving on the track. */
+    const std::vector<std::shared_ptr<Flyable> > &getActiveProjectiles() const
+                                              { return m_active_projectiles; }
 };
 
 extern ProjectileManager *projectile_manager;
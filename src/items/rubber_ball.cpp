@@ -32,6 +32,7 @@
 #include "tracks/drive_graph.hpp"
 #include "tracks/drive_node.hpp"
 #include "tracks/track.hpp"
+#include "utils/snapshot.hpp"
 
 #include "utils/log.hpp" //TODO: remove after debugging is done
 
@@ -66,6 +67,7 @@ RubberBall::RubberBall(AbstractKart *kart)
     m_id = m_next_id;
 
     m_target = NULL;
+    m_restoring_state = false;
 }   // RubberBall
 
 // ----------------------------------------------------------------------------
@@ -117,6 +119,64 @@ void RubberBall::onFireFlyable()
     initializeControlPoints(m_owner->getXYZ());
 }   // onFireFlyable
 
+// ----------------------------------------------------------------------------
+/** Saves the target, the interpolation state and the track sector of the
+ *  ball. The target is stored as its world kart id, or -1 if there is none
+ *  (e.g. in battle mode).
+ */
+void RubberBall::saveState(Snapshot *s) const
+{
+    Flyable::saveState(s);
+    TrackSector::saveState(s);
+    s->add<int>(m_target ? (int)m_target->getWorldKartId() : -1);
+    s->add(m_last_aimed_graph_node);
+    for (unsigned int i = 0; i < 4; i++)
+        s->add(m_control_points[i]);
+    s->add(m_previous_xyz);
+    s->add(m_previous_height);
+    s->add(m_length_cp_1_2);
+    s->add(m_length_cp_2_3);
+    s->add(m_t);
+    s->add(m_t_increase);
+    s->add(m_interval);
+    s->add(m_distance_to_target);
+    s->add(m_height_timer);
+    s->add(m_current_max_height);
+    s->add(m_delete_ticks);
+    s->add(m_tunnel_count);
+    s->add(m_fast_ping);
+    s->add(m_aiming_at_target);
+    s->add(m_restoring_state);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state saved with saveState. */
+void RubberBall::restoreState(Snapshot *s)
+{
+    Flyable::restoreState(s);
+    TrackSector::restoreState(s);
+    int target = s->get<int>();
+    m_target = target < 0 ? NULL : World::getWorld()->getKart(target);
+    s->get(&m_last_aimed_graph_node);
+    for (unsigned int i = 0; i < 4; i++)
+        s->get(&m_control_points[i]);
+    s->get(&m_previous_xyz);
+    s->get(&m_previous_height);
+    s->get(&m_length_cp_1_2);
+    s->get(&m_length_cp_2_3);
+    s->get(&m_t);
+    s->get(&m_t_increase);
+    s->get(&m_interval);
+    s->get(&m_distance_to_target);
+    s->get(&m_height_timer);
+    s->get(&m_current_max_height);
+    s->get(&m_delete_ticks);
+    s->get(&m_tunnel_count);
+    s->get(&m_fast_ping);
+    s->get(&m_aiming_at_target);
+    s->get(&m_restoring_state);
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Destructor, removes any playing sfx.
  */
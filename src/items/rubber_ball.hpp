@@ -221,6 +221,10 @@ public:
     //virtual HitEffect *getHitEffect() const {return NULL; }
     // ------------------------------------------------------------------------
     virtual void onFireFlyable() OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void saveState(Snapshot *s) const OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void restoreState(Snapshot *s) OVERRIDE;
 
 };   // RubberBall
 
@@ -33,6 +33,7 @@
 #include "physics/physics.hpp"
 #include "race/race_manager.hpp"
 #include "utils/mini_glm.hpp"
+#include "utils/snapshot.hpp"
 #include "utils/string_utils.hpp"
 
 /** RubberBand constructor. It creates a simple quad and attaches it to the
@@ -319,3 +320,22 @@ void RubberBand::set8BitState(uint8_t bit_state)
         m_hit_kart = World::getWorld()->getKart(kart);
     }
 }   // set8BitState
+
+// ----------------------------------------------------------------------------
+/** Saves what the rubber band is attached to and where its end is. */
+void RubberBand::saveState(Snapshot *s) const
+{
+    s->add(get8BitState());
+    s->add(m_hit_position);
+    s->add(m_end_position);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state saved with saveState. Unlike reset() this does not
+ *  test for a new hit, which could change the state of other karts. */
+void RubberBand::restoreState(Snapshot *s)
+{
+    set8BitState(s->get<uint8_t>());
+    s->get(&m_hit_position);
+    s->get(&m_end_position);
+}   // restoreState
@@ -121,6 +121,10 @@ public:
     // ------------------------------------------------------------------------
     virtual void   reset();
     virtual void   init(RaceManager::KartType type) = 0;
+    // ------------------------------------------------------------------------
+    /** Called before update(), possibly in parallel for all karts, to do
+     *  expensive read-only queries in advance. Default: nothing. */
+    virtual void   prepareUpdate(int ticks) {}
     // ========================================================================
     // Functions related to controlling the kart
     // ------------------------------------------------------------------------
@@ -0,0 +1,103 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2006-2015 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#include "karts/compiled_characteristic.hpp"
+
+#include "utils/log.hpp"
+
+#include <algorithm>
+
+CompiledCharacteristic::CompiledCharacteristic()
+{
+    std::fill(m_is_set, m_is_set + AbstractCharacteristic::CHARACTERISTIC_COUNT,
+              false);
+    std::fill(m_float_values,
+              m_float_values + AbstractCharacteristic::CHARACTERISTIC_COUNT,
+              0.0f);
+    std::fill(m_bool_values,
+              m_bool_values + AbstractCharacteristic::CHARACTERISTIC_COUNT,
+              false);
+    std::fill(m_vector_start,
+              m_vector_start + AbstractCharacteristic::CHARACTERISTIC_COUNT, 0);
+    std::fill(m_vector_size,
+              m_vector_size + AbstractCharacteristic::CHARACTERISTIC_COUNT, 0);
+    std::fill(m_interpolation_index,
+              m_interpolation_index + AbstractCharacteristic::CHARACTERISTIC_COUNT,
+              0);
+}   // CompiledCharacteristic
+
+// ----------------------------------------------------------------------------
+/** Evaluates all characteristics of the source once and stores the results
+ *  in this table.
+ *  \param source The (usually combined) characteristic to compile.
+ */
+void CompiledCharacteristic::compile(const AbstractCharacteristic *source)
+{
+    m_vector_values.clear();
+    m_interpolation_arrays.clear();
+    for (int i = 0; i < AbstractCharacteristic::CHARACTERISTIC_COUNT; i++)
+    {
+        CharacteristicType type = static_cast<CharacteristicType>(i);
+        bool is_set = false;
+        switch (AbstractCharacteristic::getType(type))
+        {
+        case AbstractCharacteristic::TYPE_FLOAT:
+        {
+            float value = 0.0f;
+            source->process(type, &value, &is_set);
+            m_float_values[i] = value;
+            break;
+        }
+        case AbstractCharacteristic::TYPE_BOOL:
+        {
+            bool value = false;
+            source->process(type, &value, &is_set);
+            m_bool_values[i] = value;
+            break;
+        }
+        case AbstractCharacteristic::TYPE_FLOAT_VECTOR:
+        {
+            std::vector<float> value;
+            source->process(type, &value, &is_set);
+            m_vector_start[i] = (unsigned short)m_vector_values.size();
+            m_vector_size[i]  = (unsigned short)value.size();
+            m_vector_values.insert(m_vector_values.end(), value.begin(),
+                                   value.end());
+            break;
+        }
+        case AbstractCharacteristic::TYPE_INTERPOLATION_ARRAY:
+        {
+            InterpolationArray value;
+            source->process(type, &value, &is_set);
+            m_interpolation_index[i] =
+                (unsigned char)m_interpolation_arrays.size();
+            m_interpolation_arrays.push_back(value);
+            break;
+        }
+        }   // switch (type)
+        m_is_set[i] = is_set;
+    }   // foreach characteristic
+}   // compile
+
+// ----------------------------------------------------------------------------
+/** Called if a characteristic is queried that none of the sources set. */
+void CompiledCharacteristic::notSet(CharacteristicType type) const
+{
+    Log::fatal("CompiledCharacteristic", "Can't get characteristic %s",
+               AbstractCharacteristic::getName(type).c_str());
+}   // notSet
@@ -0,0 +1,129 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2006-2015 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef HEADER_COMPILED_CHARACTERISTICS_HPP
+#define HEADER_COMPILED_CHARACTERISTICS_HPP
+
+#include "karts/abstract_characteristic.hpp"
+#include "utils/interpolation_array.hpp"
+
+#include <assert.h>
+#include <vector>
+
+/** A read-only view of a contiguous range of floats, used to hand out
+ *  vector-valued characteristics without copying them.
+ */
+class FloatSpan
+{
+private:
+    const float *m_data;
+    unsigned int m_size;
+
+public:
+    FloatSpan(const float *data = nullptr, unsigned int size = 0)
+        : m_data(data), m_size(size) {}
+    // ------------------------------------------------------------------------
+    unsigned int size() const { return m_size; }
+    // ------------------------------------------------------------------------
+    bool empty() const { return m_size == 0; }
+    // ------------------------------------------------------------------------
+    float operator[](unsigned int i) const
+    {
+        assert(i < m_size);
+        return m_data[i];
+    }
+    // ------------------------------------------------------------------------
+    const float *begin() const { return m_data; }
+    // ------------------------------------------------------------------------
+    const float *end() const { return m_data + m_size; }
+};   // FloatSpan
+
+/**
+ * A flat table of all characteristics of one kart, compiled once from a
+ * (combined) characteristic when the kart properties for a race are
+ * created. Lookups are plain array reads instead of a virtual process()
+ * call through all combined characteristics, and vector values are
+ * returned as spans into the table, so the getters used every physics
+ * tick neither call virtual functions nor allocate.
+ * The table only stores offsets, so it can be copied with the
+ * KartProperties that own it.
+ */
+class CompiledCharacteristic
+{
+private:
+    typedef AbstractCharacteristic::CharacteristicType CharacteristicType;
+
+    /** If a characteristic was set by any of the source characteristics. */
+    bool m_is_set[AbstractCharacteristic::CHARACTERISTIC_COUNT];
+
+    /** The value of all float and bool characteristics. */
+    float m_float_values[AbstractCharacteristic::CHARACTERISTIC_COUNT];
+    bool m_bool_values[AbstractCharacteristic::CHARACTERISTIC_COUNT];
+
+    /** Index of the first element and number of elements of all float
+     *  vector characteristics in m_vector_values. */
+    unsigned short m_vector_start[AbstractCharacteristic::CHARACTERISTIC_COUNT];
+    unsigned short m_vector_size[AbstractCharacteristic::CHARACTERISTIC_COUNT];
+
+    /** Index of all interpolation array characteristics in
+     *  m_interpolation_arrays. */
+    unsigned char m_interpolation_index[AbstractCharacteristic::CHARACTERISTIC_COUNT];
+
+    /** The elements of all float vector characteristics. */
+    std::vector<float> m_vector_values;
+
+    /** All interpolation array characteristics. */
+    std::vector<InterpolationArray> m_interpolation_arrays;
+
+    void notSet(CharacteristicType type) const;
+
+public:
+    CompiledCharacteristic();
+    void compile(const AbstractCharacteristic *source);
+
+    // ------------------------------------------------------------------------
+    /** Returns if any of the source characteristics set this value. */
+    bool isSet(CharacteristicType type) const { return m_is_set[type]; }
+    // ------------------------------------------------------------------------
+    float getFloat(CharacteristicType type) const
+    {
+        if (!m_is_set[type]) notSet(type);
+        return m_float_values[type];
+    }   // getFloat
+    // ------------------------------------------------------------------------
+    bool getBool(CharacteristicType type) const
+    {
+        if (!m_is_set[type]) notSet(type);
+        return m_bool_values[type];
+    }   // getBool
+    // ------------------------------------------------------------------------
+    FloatSpan getFloatVector(CharacteristicType type) const
+    {
+        if (!m_is_set[type]) notSet(type);
+        return FloatSpan(m_vector_values.data() + m_vector_start[type],
+                         m_vector_size[type]);
+    }   // getFloatVector
+    // ------------------------------------------------------------------------
+    const InterpolationArray& getInterpolationArray(CharacteristicType type) const
+    {
+        if (!m_is_set[type]) notSet(type);
+        return m_interpolation_arrays[m_interpolation_index[type]];
+    }   // getInterpolationArray
+};   // CompiledCharacteristic
+
+#endif
@@ -25,9 +25,11 @@
 #include "karts/kart_properties.hpp"
 #include "karts/controller/ai_properties.hpp"
 #include "modes/world.hpp"
+#include "race/race_manager.hpp"
 
 #include "tracks/track.hpp"
 #include "utils/constants.hpp"
+#include "utils/snapshot.hpp"
 
 #include <assert.h>
 
@@ -39,16 +41,40 @@ AIBaseController::AIBaseController(AbstractKart *kart)
     m_kart_width    = m_kart->getKartWidth();
     m_ai_properties = m_kart->getKartProperties()
                             ->getAIPropertiesForDifficulty();
+    m_random.seed(RandomGenerator::deriveSeed(race_manager->getRandomSeed(),
+                                              RandomGenerator::RS_AI,
+                                              m_kart->getWorldKartId()));
 }   // AIBaseController
 
 //-----------------------------------------------------------------------------
 
 void AIBaseController::reset()
 {
-    m_stuck = false;
-    m_collision_ticks.clear();
+    resetStuck();
+    m_random.seed(RandomGenerator::deriveSeed(race_manager->getRandomSeed(),
+                                              RandomGenerator::RS_AI,
+                                              m_kart->getWorldKartId()));
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the random generator and the stuck detection. */
+void AIBaseController::saveState(Snapshot *s) const
+{
+    s->add(m_random);
+    s->add(m_stuck);
+    s->add(m_collision_ticks);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+void AIBaseController::restoreState(Snapshot *s)
+{
+    s->get(&m_random);
+    s->get(&m_stuck);
+    m_collision_ticks.resize(s->get<uint32_t>());
+    for (unsigned int i = 0; i < m_collision_ticks.size(); i++)
+        s->get(&m_collision_ticks[i]);
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 
 void AIBaseController::update(int ticks)
@@ -146,7 +172,7 @@ float AIBaseController::steerToPoint(const Vec3 &point)
  *  \param angle Angle to normalise.
  *  \return Normalised angle.
  */
-float AIBaseController::normalizeAngle(float angle)
+float AIBaseController::normalizeAngle(float angle) const
 {
     // Add an assert here since we had cases in which an invalid angle
     // was given, resulting in an endless loop (floating point precision,
@@ -44,7 +44,8 @@ private:
     bool m_stuck;
 
 protected:
-    /** A random number generator for all AI decisions. */
+    /** A random number generator for all AI decisions, it is seeded per
+     *  kart from the race seed in reset(). */
     RandomGenerator m_random;
 
     /** Length of the kart, storing it here saves many function calls. */
@@ -61,12 +62,15 @@ protected:
 
     void         setControllerName(const std::string &name) OVERRIDE;
     float        steerToPoint(const Vec3 &point);
-    float        normalizeAngle(float angle);
+    float        normalizeAngle(float angle) const;
     // ------------------------------------------------------------------------
     /** This can be called to detect if the kart is stuck (i.e. repeatedly
     *  hitting part of the track). */
     bool         isStuck() const { return m_stuck; }
     // ------------------------------------------------------------------------
+    /** Clears the stuck detection, without resetting the rest of the AI. */
+    void         resetStuck() { m_stuck = false; m_collision_ticks.clear(); }
+    // ------------------------------------------------------------------------
     void         determineTurnRadius(const Vec3 &end, Vec3 *center,
                                      float *radius) const;
     virtual void setSteering   (float angle, float dt);
@@ -78,6 +82,8 @@ public:
              AIBaseController(AbstractKart *kart);
     virtual ~AIBaseController() {};
     virtual void reset() OVERRIDE;
+    virtual void saveState(Snapshot *s) const OVERRIDE;
+    virtual void restoreState(Snapshot *s) OVERRIDE;
     virtual bool disableSlipstreamBonus() const OVERRIDE;
     virtual void crashed(const Material *m) OVERRIDE;
     virtual void crashed(const AbstractKart *k) OVERRIDE {};
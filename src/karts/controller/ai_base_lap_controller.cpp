@@ -28,6 +28,7 @@
 #include "tracks/drive_graph.hpp"
 #include "tracks/track.hpp"
 #include "utils/constants.hpp"
+#include "utils/snapshot.hpp"
 
 
 /**
@@ -113,6 +114,10 @@ AIBaseLapController::AIBaseLapController(AbstractKart *kart)
 void AIBaseLapController::reset()
 {
     AIBaseController::reset();
+    // Pick the path again with the freshly seeded random generator, so that
+    // a restarted race takes the same path as the first one
+    if (m_world)
+        computePath();
 }   // reset
 
 
@@ -160,15 +165,19 @@ void AIBaseLapController::computePath()
         // race. Long term statistics might be gathered to determine the
         // best way, potentially depending on race position etc.
         // TODO: Make this a property of the kart
-        int r = rand();
-        int indx = (int)( r / ((float)(RAND_MAX)+1.0f) * next.size() );
-        // In case of rounding errors0
-        if(indx>=(int)next.size()) indx--;
+        int indx = m_random.get((int)next.size());
         m_successor_index[i] = indx;
         assert(indx <(int)next.size() && indx>=0);
         m_next_node_index[i] = next[indx];
     }
+    computeLookAheads();
+}   // computePath
 
+//-----------------------------------------------------------------------------
+/** Computes m_all_look_aheads from the path chosen in computePath.
+ */
+void AIBaseLapController::computeLookAheads()
+{
     const unsigned int look_ahead=10;
     // Now compute for each node in the graph the list of the next 'look_ahead'
     // graph nodes. This is the list of node that is tested in checkCrashes.
@@ -190,7 +199,28 @@ void AIBaseLapController::computePath()
         }   // for j<look_ahead
         m_all_look_aheads[i] = l;
     }
-}   // computePath
+}   // computeLookAheads
+
+//-----------------------------------------------------------------------------
+/** Saves the random generator and the path chosen by the AI. */
+void AIBaseLapController::saveState(Snapshot *s) const
+{
+    AIBaseController::saveState(s);
+    s->add(m_track_node);
+    s->add(m_successor_index);
+    s->add(m_next_node_index);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+void AIBaseLapController::restoreState(Snapshot *s)
+{
+    AIBaseController::restoreState(s);
+    s->get(&m_track_node);
+    s->get(&m_successor_index);
+    s->get(&m_next_node_index);
+    if (m_world)
+        computeLookAheads();
+}   // restoreState
 
 //-----------------------------------------------------------------------------
 /** Updates the ai base controller each time step. Note that any calls to
@@ -61,6 +61,7 @@ protected:
     float    steerToAngle  (const unsigned int sector, const float angle);
 
     void     computePath();
+    void     computeLookAheads();
     // ------------------------------------------------------------------------
     /** Nothing special to do when the race is finished. */
     virtual void raceFinished() {};
@@ -69,6 +70,8 @@ public:
              AIBaseLapController(AbstractKart *kart);
     virtual ~AIBaseLapController() {};
     virtual void reset();
+    virtual void saveState(Snapshot *s) const;
+    virtual void restoreState(Snapshot *s);
 };   // AIBaseLapController
 
 #endif
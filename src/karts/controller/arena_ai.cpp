@@ -28,6 +28,7 @@
 #include "karts/rescue_animation.hpp"
 #include "tracks/arena_graph.hpp"
 #include "tracks/arena_node.hpp"
+#include "utils/snapshot.hpp"
 
 #include <algorithm>
 
@@ -69,6 +70,60 @@ void ArenaAI::reset()
     AIBaseController::reset();
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the target and the timers of the AI. The closest kart is found
+ *  again in each update, so it is not saved.
+ */
+void ArenaAI::saveState(Snapshot *s) const
+{
+    AIBaseController::saveState(s);
+    s->add(m_target_node);
+    s->add(m_target_point);
+    s->add(m_mini_skid);
+    s->add(m_target_point_lc);
+    s->add(m_reverse_point);
+    s->add(m_is_stuck);
+    s->add(m_is_uturn);
+    s->add<uint32_t>((uint32_t)m_on_node.size());
+    for (int node : m_on_node)
+        s->add(node);
+    s->add(m_time_since_last_shot);
+    s->add(m_ticks_since_reversing);
+    s->add(m_time_since_driving);
+    s->add(m_time_since_uturn);
+    s->add(m_ticks_since_off_road);
+    s->add(m_turn_radius);
+    s->add(m_steering_angle);
+    s->add(m_current_forward_point);
+    s->add(m_current_forward_node);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+void ArenaAI::restoreState(Snapshot *s)
+{
+    AIBaseController::restoreState(s);
+    s->get(&m_target_node);
+    s->get(&m_target_point);
+    s->get(&m_mini_skid);
+    s->get(&m_target_point_lc);
+    s->get(&m_reverse_point);
+    s->get(&m_is_stuck);
+    s->get(&m_is_uturn);
+    m_on_node.clear();
+    unsigned int num_nodes = s->get<uint32_t>();
+    for (unsigned int i = 0; i < num_nodes; i++)
+        m_on_node.insert(s->get<int>());
+    s->get(&m_time_since_last_shot);
+    s->get(&m_ticks_since_reversing);
+    s->get(&m_time_since_driving);
+    s->get(&m_time_since_uturn);
+    s->get(&m_ticks_since_off_road);
+    s->get(&m_turn_radius);
+    s->get(&m_steering_angle);
+    s->get(&m_current_forward_point);
+    s->get(&m_current_forward_node);
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** This is the main entry point for the AI.
  *  It is called once per frame for each AI and determines the behaviour of
@@ -321,7 +376,7 @@ void ArenaAI::checkIfStuck(const float dt)
         // AI is stuck, reset now and try to get unstuck at next frame
         m_on_node.clear();
         m_time_since_driving = 0.0f;
-        AIBaseController::reset();
+        resetStuck();
         m_is_stuck = true;
     }
     else if (m_time_since_driving >=
@@ -188,6 +188,10 @@ public:
     // ------------------------------------------------------------------------
     virtual void reset() OVERRIDE;
     // ------------------------------------------------------------------------
+    virtual void saveState(Snapshot *s) const OVERRIDE;
+    // ------------------------------------------------------------------------
+    virtual void restoreState(Snapshot *s) OVERRIDE;
+    // ------------------------------------------------------------------------
     virtual void newLap(int lap) OVERRIDE {}
 
 };
@@ -29,9 +29,11 @@ using namespace irr;
 #include "input/input.hpp"
 
 class AbstractKart;
+class btTransform;
 class ItemState;
 class KartControl;
 class Material;
+class Snapshot;
 
 /** This is the base class for kart controller - that can be a player
  *  or a a robot.
@@ -57,6 +59,21 @@ public:
     virtual      ~Controller         () {};
     virtual void  reset              () = 0;
     virtual void  update             (int ticks) = 0;
+    // ------------------------------------------------------------------------
+    /** Called before update() to do expensive read-only computations in
+     *  advance. This can be called for all karts in parallel, so it must
+     *  not change anything but the state of this controller, and update()
+     *  must only use the results if their inputs did not change.
+     *  \param trans The transform the kart will most likely have when
+     *         update() is called. */
+    virtual void  prepareUpdate      (int ticks, const btTransform &trans) {}
+    // ------------------------------------------------------------------------
+    /** Saves the internal state of the controller (e.g. random generators
+     *  and decisions of an AI), see Kart::saveState. */
+    virtual void  saveState          (Snapshot *s) const {}
+    // ------------------------------------------------------------------------
+    /** Restores the state saved with saveState. */
+    virtual void  restoreState       (Snapshot *s) {}
     virtual void  handleZipper       () = 0;
     virtual void  collectedItem      (const ItemState &item,
                                       float previous_energy=0) = 0;
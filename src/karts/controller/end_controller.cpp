@@ -49,6 +49,7 @@
 #include "tracks/track.hpp"
 #include "utils/constants.hpp"
 #include "utils/log.hpp"
+#include "utils/snapshot.hpp"
 
 EndController::EndController(AbstractKart *kart,
                              Controller *prev_controller)
@@ -144,6 +145,22 @@ void EndController::reset()
     m_min_steps = 2;
 }   // reset
 
+//-----------------------------------------------------------------------------
+void EndController::saveState(Snapshot *s) const
+{
+    AIBaseLapController::saveState(s);
+    s->add(m_crash_time);
+    s->add(m_time_since_stuck);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+void EndController::restoreState(Snapshot *s)
+{
+    AIBaseLapController::restoreState(s);
+    s->get(&m_crash_time);
+    s->get(&m_time_since_stuck);
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Callback when a new lap is triggered. It is used to switch to the first
  *  end camera (which is esp. useful in fixing up end cameras in reverse mode,
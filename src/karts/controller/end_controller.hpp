@@ -86,6 +86,8 @@ public:
                 ~EndController();
     virtual void update      (int ticks) ;
     virtual void reset       ();
+    virtual void saveState   (Snapshot *s) const;
+    virtual void restoreState(Snapshot *s);
     virtual bool action      (PlayerAction action, int value,
                               bool dry_run = false);
     virtual void newLap      (int lap);
@@ -30,6 +30,7 @@
 #include "modes/world.hpp"
 #include "utils/constants.hpp"
 #include "utils/log.hpp"
+#include "utils/snapshot.hpp"
 #include "utils/string_utils.hpp"
 
 #include <cstdlib>
@@ -62,6 +63,31 @@ void PlayerController::reset()
     m_penalty_ticks = 0;
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the steering and the previous input state. */
+void PlayerController::saveState(Snapshot *s) const
+{
+    s->add(m_steer_val);
+    s->add(m_steer_val_l);
+    s->add(m_steer_val_r);
+    s->add(m_prev_accel);
+    s->add(m_prev_brake);
+    s->add(m_prev_nitro);
+    s->add(m_penalty_ticks);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+void PlayerController::restoreState(Snapshot *s)
+{
+    s->get(&m_steer_val);
+    s->get(&m_steer_val_l);
+    s->get(&m_steer_val_r);
+    s->get(&m_prev_accel);
+    s->get(&m_prev_brake);
+    s->get(&m_prev_nitro);
+    s->get(&m_penalty_ticks);
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Resets the state of control keys. This is used after the in-game menu to
  *  avoid that any keys pressed at the time the menu is opened are still
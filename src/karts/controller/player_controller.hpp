@@ -47,6 +47,8 @@ public:
                                    int value_l, int value_r);
     virtual void skidBonusTriggered() OVERRIDE;
     virtual void reset             () OVERRIDE;
+    virtual void saveState         (Snapshot *s) const OVERRIDE;
+    virtual void restoreState      (Snapshot *s) OVERRIDE;
     virtual void handleZipper() OVERRIDE;
     virtual void resetInputState();
     // ------------------------------------------------------------------------
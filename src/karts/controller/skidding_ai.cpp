@@ -44,6 +44,7 @@
 #include "tracks/track.hpp"
 #include "utils/constants.hpp"
 #include "utils/log.hpp"
+#include "utils/snapshot.hpp"
 #include "utils/vs.hpp"
 
 #ifdef AI_DEBUG
@@ -171,6 +172,7 @@ void SkiddingAI::reset()
     m_skid_probability_state     = SKID_PROBAB_NOT_YET;
     m_last_item_random           = NULL;
     m_burster                    = false;
+    m_aim_prepared               = false;
 
     AIBaseLapController::reset();
     m_track_node               = Graph::UNKNOWN_SECTOR;
@@ -187,6 +189,78 @@ void SkiddingAI::reset()
     AIBaseLapController::reset();
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the random generators and the decisions of the AI. Karts and items
+ *  are saved by their index, since the snapshot must not contain pointers.
+ */
+void SkiddingAI::saveState(Snapshot *s) const
+{
+    AIBaseLapController::saveState(s);
+    s->add(m_crashes);
+    s->add<int>(m_kart_ahead  ? m_kart_ahead->getWorldKartId()  : -1);
+    s->add<int>(m_kart_behind ? m_kart_behind->getWorldKartId() : -1);
+    s->add(m_distance_ahead);
+    s->add(m_distance_behind);
+    s->add(m_distance_leader);
+    s->add(m_time_since_last_shot);
+    s->add(m_time_since_stuck);
+    s->add(m_start_kart_crash_direction);
+    s->add(m_current_track_direction);
+    s->add(m_current_curve_radius);
+    s->add(m_curve_center);
+    s->add(m_last_direction_node);
+    s->add<int>(m_item_to_collect ? (int)m_item_to_collect->getItemId() : -1);
+    s->add(m_avoid_item_close);
+    s->add(m_distance_to_player);
+    s->add(m_num_players_ahead);
+    s->add(m_burster);
+    s->add(m_skid_probability_state);
+    s->add<int>(m_last_item_random ? (int)m_last_item_random->getItemId()
+                                   : -1);
+    s->add(m_really_collect_item);
+    s->add(m_random_collect_item);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state saved with saveState. The aim point computed by
+ *  prepareUpdate is discarded.
+ */
+void SkiddingAI::restoreState(Snapshot *s)
+{
+    AIBaseLapController::restoreState(s);
+    World *world = World::getWorld();
+    ItemManager *im = ItemManager::get();
+    s->get(&m_crashes);
+    int kart_ahead  = s->get<int>();
+    int kart_behind = s->get<int>();
+    m_kart_ahead  = kart_ahead  >= 0 ? world->getKart(kart_ahead)  : NULL;
+    m_kart_behind = kart_behind >= 0 ? world->getKart(kart_behind) : NULL;
+    s->get(&m_distance_ahead);
+    s->get(&m_distance_behind);
+    s->get(&m_distance_leader);
+    s->get(&m_time_since_last_shot);
+    s->get(&m_time_since_stuck);
+    s->get(&m_start_kart_crash_direction);
+    s->get(&m_current_track_direction);
+    s->get(&m_current_curve_radius);
+    s->get(&m_curve_center);
+    s->get(&m_last_direction_node);
+    int item_to_collect = s->get<int>();
+    m_item_to_collect = item_to_collect >= 0 ? im->getItem(item_to_collect)
+                                             : NULL;
+    s->get(&m_avoid_item_close);
+    s->get(&m_distance_to_player);
+    s->get(&m_num_players_ahead);
+    s->get(&m_burster);
+    s->get(&m_skid_probability_state);
+    int last_item_random = s->get<int>();
+    m_last_item_random = last_item_random >= 0 ? im->getItem(last_item_random)
+                                               : NULL;
+    s->get(&m_really_collect_item);
+    s->get(&m_random_collect_item);
+    m_aim_prepared = false;
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Returns a name for the AI.
  *  This is used in profile mode when comparing different AI implementations
@@ -288,6 +362,27 @@ void SkiddingAI::update(int ticks)
     AIBaseLapController::update(ticks);
 }   // update
 
+//-----------------------------------------------------------------------------
+/** Computes the point to aim at for the expected kart position in advance
+ *  (see findNonCrashingPoint()). This only reads the drive graph and the
+ *  path of this AI, so it can run in parallel for all karts.
+ *  \param ticks Number of physics time steps - should be 1.
+ *  \param trans The transform the kart is expected to have in update().
+ */
+void SkiddingAI::prepareUpdate(int ticks, const btTransform &trans)
+{
+    m_aim_prepared = false;
+    if (m_point_selection_algorithm != PSA_DEFAULT ||
+        m_track_node == Graph::UNKNOWN_SECTOR)
+        return;
+    m_prepared_ticks      = m_world->getTicksSinceStart();
+    m_prepared_xyz        = trans.getOrigin();
+    m_prepared_track_node = m_track_node;
+    computeNonCrashingPoint(m_prepared_xyz, &m_prepared_aim_point,
+                            &m_prepared_last_node);
+    m_aim_prepared = true;
+}   // prepareUpdate
+
 //-----------------------------------------------------------------------------
 /** Decides in which direction to steer. If the kart is off track, it will
  *  steer towards the center of the track. Otherwise it will call one of
@@ -2510,6 +2605,32 @@ void SkiddingAI::findNonCrashingPointNew(Vec3 *result, int *last_node)
     Vec3 forw(0, 0, 50);
     m_curve[CURVE_KART]->addPoint(m_kart->getTrans()(forw)+eps);
 #endif
+    // Use the result of prepareUpdate() if it was computed for this tick,
+    // position and graph node.
+    const Vec3 &xyz = m_kart->getXYZ();
+    if (m_aim_prepared &&
+        m_prepared_ticks == m_world->getTicksSinceStart() &&
+        m_prepared_track_node == m_track_node &&
+        m_prepared_xyz.getX() == xyz.getX() &&
+        m_prepared_xyz.getY() == xyz.getY() &&
+        m_prepared_xyz.getZ() == xyz.getZ()    )
+    {
+        *aim_position = m_prepared_aim_point;
+        *last_node    = m_prepared_last_node;
+        return;
+    }
+    computeNonCrashingPoint(xyz, aim_position, last_node);
+}   // findNonCrashingPoint
+
+//-----------------------------------------------------------------------------
+/** Implements findNonCrashingPoint() for a given kart position.
+ *  \param xyz The position of the kart.
+ *  \param aim_position On exit contains the point the AI should aim at.
+ *  \param last_node On exit contais the graph node the AI is aiming at.
+ */
+void SkiddingAI::computeNonCrashingPoint(const Vec3 &xyz, Vec3 *aim_position,
+                                         int *last_node) const
+{
     *last_node = m_next_node_index[m_track_node];
     float angle = DriveGraph::get()->getAngleToNext(m_track_node,
                                               m_successor_index[m_track_node]);
@@ -2540,7 +2661,7 @@ void SkiddingAI::findNonCrashingPointNew(Vec3 *result, int *last_node)
 
         //direction is a vector from our kart to the sectors we are testing
         direction = DriveGraph::get()->getNode(target_sector)->getCenter()
-                  - m_kart->getXYZ();
+                  - xyz;
 
         float len=direction.length();
         unsigned int steps = (unsigned int)( len / m_kart_length );
@@ -2560,7 +2681,7 @@ void SkiddingAI::findNonCrashingPointNew(Vec3 *result, int *last_node)
         //Test if we crash if we drive towards the target sector
         for(unsigned int i = 2; i < steps; ++i )
         {
-            step_coord = m_kart->getXYZ()+direction*m_kart_length * float(i);
+            step_coord = xyz+direction*m_kart_length * float(i);
 
             DriveGraph::get()->spatialToTrack(&step_track_coord, step_coord,
                                              *last_node );
@@ -2580,7 +2701,7 @@ void SkiddingAI::findNonCrashingPointNew(Vec3 *result, int *last_node)
         *last_node = target_sector;
     }   // for i<100
     *aim_position = DriveGraph::get()->getNode(*last_node)->getCenter();
-}   // findNonCrashingPoint
+}   // computeNonCrashingPoint
 
 //-----------------------------------------------------------------------------
 /** Determines the direction of the track ahead of the kart: 0 indicates
@@ -226,6 +226,16 @@ private:
     enum {PSA_DEFAULT, PSA_NEW}
           m_point_selection_algorithm;
 
+    /** The point to aim at and its graph node as computed by prepareUpdate()
+     *  for the kart position m_prepared_xyz on node m_prepared_track_node
+     *  in tick m_prepared_ticks. */
+    bool  m_aim_prepared;
+    int   m_prepared_ticks;
+    Vec3  m_prepared_xyz;
+    int   m_prepared_track_node;
+    Vec3  m_prepared_aim_point;
+    int   m_prepared_last_node;
+
 #ifdef AI_DEBUG
     /** For skidding debugging: shows the estimated turn shape. */
     ShowCurve **m_curve;
@@ -279,6 +289,8 @@ private:
     void  checkCrashes(const Vec3& pos);
     void  findNonCrashingPointNew(Vec3 *result, int *last_node);
     void  findNonCrashingPoint(Vec3 *result, int *last_node);
+    void  computeNonCrashingPoint(const Vec3 &xyz, Vec3 *result,
+                                  int *last_node) const;
 
     void  determineTrackDirection();
     virtual bool canSkid(float steer_fraction);
@@ -292,7 +304,10 @@ public:
                  SkiddingAI(AbstractKart *kart);
                 ~SkiddingAI();
     virtual void update      (int ticks);
+    virtual void prepareUpdate(int ticks, const btTransform &trans);
     virtual void reset       ();
+    virtual void saveState   (Snapshot *s) const;
+    virtual void restoreState(Snapshot *s);
     virtual const irr::core::stringw& getNamePostfix() const;
 };
 
@@ -26,6 +26,7 @@
 #include "modes/soccer_world.hpp"
 #include "tracks/arena_graph.hpp"
 #include "tracks/track.hpp"
+#include "utils/snapshot.hpp"
 
 #ifdef AI_DEBUG
 #include "irrlicht.h"
@@ -102,6 +103,26 @@ void SoccerAI::reset()
 
 }   // reset
 
+//-----------------------------------------------------------------------------
+void SoccerAI::saveState(Snapshot *s) const
+{
+    ArenaAI::saveState(s);
+    s->add(m_overtake_ball);
+    s->add(m_force_brake);
+    s->add(m_chasing_ball);
+    s->add(m_front_transform);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+void SoccerAI::restoreState(Snapshot *s)
+{
+    ArenaAI::restoreState(s);
+    s->get(&m_overtake_ball);
+    s->get(&m_force_brake);
+    s->get(&m_chasing_ball);
+    s->get(&m_front_transform);
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Update \ref m_front_transform for ball aiming functions, also make AI stop
  *  after goal.
@@ -103,6 +103,8 @@ public:
                 ~SoccerAI();
     virtual void update (int ticks) OVERRIDE;
     virtual void reset() OVERRIDE;
+    virtual void saveState(Snapshot *s) const OVERRIDE;
+    virtual void restoreState(Snapshot *s) OVERRIDE;
 
 };
 
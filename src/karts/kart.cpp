@@ -42,7 +42,6 @@
 #include "items/projectile_manager.hpp"
 #include "karts/abstract_characteristic.hpp"
 #include "karts/abstract_kart_animation.hpp"
-#include "karts/cached_characteristic.hpp"
 #include "karts/controller/local_player_controller.hpp"
 #include "karts/controller/end_controller.hpp"
 #include "karts/controller/spare_tire_ai.hpp"
@@ -70,6 +69,7 @@
 #include "utils/helpers.hpp"
 #include "utils/log.hpp" //TODO: remove after debugging is done
 #include "utils/profiler.hpp"
+#include "utils/snapshot.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/vs.hpp"
 
@@ -365,6 +365,123 @@ void Kart::reset()
 
 }   // reset
 
+// -----------------------------------------------------------------------------
+/** Saves the physical and gameplay state of this kart (rigid body, vehicle,
+ *  skidding, speed modifiers, attachment and powerup) into a snapshot.
+ *  Graphical effects are not saved, the controller is saved by the world.
+ */
+void Kart::saveState(Snapshot *s) const
+{
+    Moveable::saveState(s);
+    m_vehicle->saveState(s);
+    m_skidding->saveState(s);
+    m_max_speed->saveState(s);
+    m_attachment->saveState(s);
+    m_powerup->saveState(s);
+
+    s->add(m_controls);
+    s->add(m_xyz_front);
+    s->add(m_previous_xyz);
+    s->add(m_previous_xyz_times);
+    s->add(m_time_previous_counter);
+    s->add(m_is_jumping);
+    s->add(m_bubblegum_torque_sign);
+    s->add(m_bounce_back_ticks);
+    s->add(m_last_used_powerup);
+    s->add(m_flying);
+    s->add(m_has_caught_nolok_bubblegum);
+    s->add(m_eliminated);
+    s->add(m_race_position);
+    s->add(m_brake_ticks);
+    s->add(m_invulnerable_ticks);
+    s->add(m_bubblegum_ticks);
+    s->add(m_view_blocked_by_plunger);
+    s->add(m_current_lean);
+    s->add(m_min_nitro_ticks);
+    s->add(m_fire_clicked);
+    s->add(m_finished_race);
+    s->add(m_finish_time);
+    s->add(m_collected_energy);
+    s->add(m_energy_to_min_ratio);
+    s->add(m_startup_boost);
+    s->add(m_falling_time);
+    s->add(m_weight);
+    s->add(m_speed);
+    s->add(m_ticks_last_crash);
+    s->add(m_ticks_last_zipper);
+}   // saveState
+
+// -----------------------------------------------------------------------------
+/** Restores the state saved with saveState. A running kart animation (e.g.
+ *  rescue or explosion) is cancelled, since animations are not saved.
+ */
+void Kart::restoreState(Snapshot *s)
+{
+    if (m_kart_animation)
+    {
+        m_kart_animation->handleResetRace();
+        delete m_kart_animation;
+        m_kart_animation = NULL;
+        Physics::getInstance()->removeKart(this);
+        Physics::getInstance()->addKart(this);
+    }
+
+    Moveable::restoreState(s);
+    m_vehicle->restoreState(s);
+    m_skidding->restoreState(s);
+    m_max_speed->restoreState(s);
+    m_attachment->restoreState(s);
+    m_powerup->restoreState(s);
+
+    s->get(&m_controls);
+    s->get(&m_xyz_front);
+    s->get(&m_previous_xyz);
+    s->get(&m_previous_xyz_times);
+    s->get(&m_time_previous_counter);
+    s->get(&m_is_jumping);
+    s->get(&m_bubblegum_torque_sign);
+    s->get(&m_bounce_back_ticks);
+    s->get(&m_last_used_powerup);
+    s->get(&m_flying);
+    s->get(&m_has_caught_nolok_bubblegum);
+    s->get(&m_eliminated);
+    s->get(&m_race_position);
+    s->get(&m_brake_ticks);
+    s->get(&m_invulnerable_ticks);
+    s->get(&m_bubblegum_ticks);
+    s->get(&m_view_blocked_by_plunger);
+    s->get(&m_current_lean);
+    s->get(&m_min_nitro_ticks);
+    s->get(&m_fire_clicked);
+    s->get(&m_finished_race);
+    s->get(&m_finish_time);
+    s->get(&m_collected_energy);
+    s->get(&m_energy_to_min_ratio);
+    s->get(&m_startup_boost);
+    s->get(&m_falling_time);
+    s->get(&m_weight);
+    s->get(&m_speed);
+    s->get(&m_ticks_last_crash);
+    s->get(&m_ticks_last_zipper);
+
+    // Finishing the race replaces the controller with an end controller
+    EndController *end_controller = dynamic_cast<EndController*>(m_controller);
+    if (!m_finished_race && end_controller)
+    {
+        m_controller       = m_saved_controller;
+        m_saved_controller = NULL;
+        delete end_controller;
+        m_kart_model->setAnimation(KartModel::AF_DEFAULT);
+    }
+    else if (m_finished_race && !end_controller && !m_saved_controller)
+    {
+        setController(new EndController(this, m_controller));
+    }
+
+    m_terrain_info->update(getTrans().getBasis(),
+        getTrans().getOrigin() + getTrans().getBasis() * Vec3(0, 0.3f, 0));
+}   // restoreState
+
 // -----------------------------------------------------------------------------
 void Kart::setXYZ(const Vec3& a)
 {
@@ -637,7 +754,7 @@ void Kart::createPhysics()
     trans.setIdentity();
     createBody(mass, trans, m_kart_chassis.get(),
                m_kart_properties->getRestitution(0.0f));
-    std::vector<float> ang_fact = m_kart_properties->getStabilityAngularFactor();
+    FloatSpan ang_fact = m_kart_properties->getStabilityAngularFactor();
     // The angular factor (with X and Z values <1) helps to keep the kart
     // upright, especially in case of a collision.
     m_body->setAngularFactor(Vec3(ang_fact[0], ang_fact[1], ang_fact[2]));
@@ -759,13 +876,9 @@ void Kart::updateWeight()
  *  \param radius The radius for which the speed needs to be computed. */
 float Kart::getSpeedForTurnRadius(float radius) const
 {
-    InterpolationArray turn_angle_at_speed = m_kart_properties->getTurnRadius();
     // Convert the turn radius into turn angle
-    for(int i = 0; i < (int)turn_angle_at_speed.size(); i++)
-        turn_angle_at_speed.setY(i, sinf( 1.0f / turn_angle_at_speed.getY(i)));
-
     float angle = sinf(1.0f / radius);
-    return turn_angle_at_speed.getReverse(angle);
+    return m_kart_properties->getTurnAngleAtSpeed().getReverse(angle);
 }   // getSpeedForTurnRadius
 
 // ------------------------------------------------------------------------
@@ -775,16 +888,7 @@ float Kart::getSpeedForTurnRadius(float radius) const
     real raw steer angle. */
 float Kart::getMaxSteerAngle(float speed) const
 {
-    InterpolationArray turn_angle_at_speed = m_kart_properties->getTurnRadius();
-    // Convert the turn radius into turn angle
-    // We multiply by wheel base to keep turn radius identical
-    // across karts of different lengths sharing the same
-    // turn radius properties
-    for(int i = 0; i < (int)turn_angle_at_speed.size(); i++)
-        turn_angle_at_speed.setY(i, sinf( 1.0f / turn_angle_at_speed.getY(i))
-                                    * m_kart_properties->getWheelBase());
-
-    return turn_angle_at_speed.get(speed);
+    return m_kart_properties->getMaxSteerAngleAtSpeed().get(speed);
 }   // getMaxSteerAngle
 
 //-----------------------------------------------------------------------------
@@ -965,7 +1069,7 @@ float Kart::getActualWheelForce()
 {
     float add_force = m_max_speed->getCurrentAdditionalEngineForce();
     assert(!std::isnan(add_force));
-    const std::vector<float>& gear_ratio=m_kart_properties->getGearSwitchRatio();
+    FloatSpan gear_ratio = m_kart_properties->getGearSwitchRatio();
     for(unsigned int i=0; i<gear_ratio.size(); i++)
     {
         if(m_speed <= m_kart_properties->getEngineMaxSpeed() * gear_ratio[i])
@@ -1099,6 +1203,35 @@ void Kart::eliminate()
     m_node->setVisible(false);
 }   // eliminate
 
+//-----------------------------------------------------------------------------
+/** Does the terrain raycast and the expensive parts of the controller update
+ *  in advance, based on the transform the physics step has computed for
+ *  this kart. This only reads the track and other karts and only writes
+ *  data of this kart, so it can be called for all karts in parallel.
+ *  update() uses the results only if the kart ends up with exactly the
+ *  same transform, otherwise they are computed again, so the simulation
+ *  does not depend on this being called.
+ *  \param ticks Number of physics time steps - should be 1.
+ */
+void Kart::prepareUpdate(int ticks)
+{
+    if (m_kart_animation || m_body->getInvMass() == 0)
+        return;
+
+    // This is the transform that Moveable::update() will set.
+    btTransform trans;
+    m_motion_state->getWorldTransform(trans);
+
+    // Same start point as the terrain raycast in update().
+    Vec3 from(0.0f, 0.0f, 0.0f);
+    for (unsigned int i = 0; i < 4; i++)
+        from += m_vehicle->getWheelInfo(i).m_raycastInfo.m_hardPointWS;
+    from = from/4 + (trans.getBasis() * Vec3(0.0f, 0.3f, 0.0f));
+    m_terrain_info->prepareUpdate(trans.getBasis(), from);
+
+    m_controller->prepareUpdate(ticks, trans);
+}   // prepareUpdate
+
 //-----------------------------------------------------------------------------
 /** Updates the kart in each time step. It updates the physics setting,
  *  particle effects, camera position, etc.
@@ -1178,7 +1311,9 @@ void Kart::update(int ticks)
     // based on the collision speed.
     m_body->setRestitution(m_kart_properties->getRestitution(fabsf(m_speed)));
 
+    PROFILER_PUSH_CPU_MARKER("Kart::update (controller)", 0x60, 0x34, 0x7F);
     m_controller->update(ticks);
+    PROFILER_POP_CPU_MARKER();
 
 #ifndef SERVER_ONLY
 #undef DEBUG_CAMERA_SHAKE
@@ -2692,6 +2827,9 @@ btQuaternion Kart::getVisualRotation() const
 void Kart::setOnScreenText(const core::stringw& text)
 {
 #ifndef SERVER_ONLY
+    // No fonts are loaded in physics only mode
+    if (UserConfigParams::m_physics_only)
+        return;
     BoldFace* bold_face = font_manager->getFont<BoldFace>();
     STKTextBillboard* tb =
         new STKTextBillboard(video::SColor(255, 255, 128, 0),
@@ -282,6 +282,8 @@ public:
     virtual float getTerrainPitch(float heading) const OVERRIDE;
 
     virtual void   reset            () OVERRIDE;
+    virtual void   saveState        (Snapshot *s) const OVERRIDE;
+    virtual void   restoreState     (Snapshot *s) OVERRIDE;
     virtual void   handleZipper     (const Material *m=NULL) OVERRIDE;
     virtual bool   setSquash        (float time, float slowdown) OVERRIDE;
             void   setSquashGraphics();
@@ -291,6 +293,7 @@ public:
     virtual void   crashed          (const Material *m, const Vec3 &normal) OVERRIDE;
     virtual float  getHoT           () const OVERRIDE;
     virtual void   update           (int ticks) OVERRIDE;
+    virtual void   prepareUpdate    (int ticks) OVERRIDE;
     virtual void   finishedRace     (float time, bool from_server=false) OVERRIDE;
     virtual void   setPosition      (int p) OVERRIDE;
     virtual void   beep             () OVERRIDE;
@@ -27,7 +27,6 @@
 #include "graphics/sp/sp_shader_manager.hpp"
 #include "graphics/sp/sp_texture_manager.hpp"
 #include "io/file_manager.hpp"
-#include "karts/cached_characteristic.hpp"
 #include "karts/combined_characteristic.hpp"
 #include "karts/controller/ai_properties.hpp"
 #include "karts/kart_model.hpp"
@@ -302,6 +301,7 @@ void KartProperties::load(const std::string &filename, const std::string &node)
     // We divide by 1.425 to have a default turn radius which conforms
     // closely (+-0,1%) with the specifications in kart_characteristics.xml
     m_wheel_base = fabsf(m_kart_model->getLength()/1.425f);
+    computeSteerAngles();
 
     m_shadow_material = material_manager->getMaterialSPM(m_shadow_file, "",
         "alphablend");
@@ -352,10 +352,34 @@ void KartProperties::combineCharacteristics(PerPlayerDifficulty difficulty)
         getPlayerCharacteristic(getPerPlayerDifficultyAsString(difficulty)));
 
     m_combined_characteristic->addCharacteristic(m_characteristic.get());
-    m_cached_characteristic = std::make_shared<CachedCharacteristic>
-        (m_combined_characteristic.get());
+    m_compiled_characteristic.compile(m_combined_characteristic.get());
+    computeSteerAngles();
 }   // combineCharacteristics
 
+//-----------------------------------------------------------------------------
+/** Converts the turn radius characteristic into turn angles, and (multiplied
+ *  by the wheel base, to keep the turn radius identical across karts of
+ *  different lengths) into maximum steer angles. The kart queries these
+ *  several times per physics step, so they are only computed when the
+ *  characteristics or the wheel base change.
+ */
+void KartProperties::computeSteerAngles()
+{
+    m_turn_angle_at_speed.clear();
+    m_max_steer_angle_at_speed.clear();
+    if (!m_compiled_characteristic.isSet(AbstractCharacteristic::TURN_RADIUS))
+        return;
+
+    m_turn_angle_at_speed = getTurnRadius();
+    m_max_steer_angle_at_speed = getTurnRadius();
+    for (unsigned int i = 0; i < m_turn_angle_at_speed.size(); i++)
+    {
+        float angle = sinf(1.0f / m_turn_angle_at_speed.getY(i));
+        m_turn_angle_at_speed.setY(i, angle);
+        m_max_steer_angle_at_speed.setY(i, angle * m_wheel_base);
+    }
+}   // computeSteerAngles
+
 //-----------------------------------------------------------------------------
 /** Actually reads in the data from the xml file.
  *  \param root Root of the xml tree.
@@ -524,664 +548,771 @@ core::stringw KartProperties::getName() const
 // ----------------------------------------------------------------------------
 float KartProperties::getSuspensionStiffness() const
 {
-    return m_cached_characteristic->getSuspensionStiffness();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SUSPENSION_STIFFNESS);
 }  // getSuspensionStiffness
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSuspensionRest() const
 {
-    return m_cached_characteristic->getSuspensionRest();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SUSPENSION_REST);
 }  // getSuspensionRest
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSuspensionTravel() const
 {
-    return m_cached_characteristic->getSuspensionTravel();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SUSPENSION_TRAVEL);
 }  // getSuspensionTravel
 
 // ----------------------------------------------------------------------------
 bool KartProperties::getSuspensionExpSpringResponse() const
 {
-    return m_cached_characteristic->getSuspensionExpSpringResponse();
+    return m_compiled_characteristic.getBool(
+        AbstractCharacteristic::SUSPENSION_EXP_SPRING_RESPONSE);
 }  // getSuspensionExpSpringResponse
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSuspensionMaxForce() const
 {
-    return m_cached_characteristic->getSuspensionMaxForce();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SUSPENSION_MAX_FORCE);
 }  // getSuspensionMaxForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityRollInfluence() const
 {
-    return m_cached_characteristic->getStabilityRollInfluence();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::STABILITY_ROLL_INFLUENCE);
 }  // getStabilityRollInfluence
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityChassisLinearDamping() const
 {
-    return m_cached_characteristic->getStabilityChassisLinearDamping();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::STABILITY_CHASSIS_LINEAR_DAMPING);
 }  // getStabilityChassisLinearDamping
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityChassisAngularDamping() const
 {
-    return m_cached_characteristic->getStabilityChassisAngularDamping();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::STABILITY_CHASSIS_ANGULAR_DAMPING);
 }  // getStabilityChassisAngularDamping
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityDownwardImpulseFactor() const
 {
-    return m_cached_characteristic->getStabilityDownwardImpulseFactor();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::STABILITY_DOWNWARD_IMPULSE_FACTOR);
 }  // getStabilityDownwardImpulseFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilityTrackConnectionAccel() const
 {
-    return m_cached_characteristic->getStabilityTrackConnectionAccel();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::STABILITY_TRACK_CONNECTION_ACCEL);
 }  // getStabilityTrackConnectionAccel
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getStabilityAngularFactor() const
+FloatSpan KartProperties::getStabilityAngularFactor() const
 {
-    return m_cached_characteristic->getStabilityAngularFactor();
+    return m_compiled_characteristic.getFloatVector(
+        AbstractCharacteristic::STABILITY_ANGULAR_FACTOR);
 }  // getStabilityAngularFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getStabilitySmoothFlyingImpulse() const
 {
-    return m_cached_characteristic->getStabilitySmoothFlyingImpulse();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::STABILITY_SMOOTH_FLYING_IMPULSE);
 }  // getStabilitySmoothFlyingImpulse
 
 // ----------------------------------------------------------------------------
-InterpolationArray KartProperties::getTurnRadius() const
+const InterpolationArray& KartProperties::getTurnRadius() const
 {
-    return m_cached_characteristic->getTurnRadius();
+    return m_compiled_characteristic.getInterpolationArray(
+        AbstractCharacteristic::TURN_RADIUS);
 }  // getTurnRadius
 
 // ----------------------------------------------------------------------------
 float KartProperties::getTurnTimeResetSteer() const
 {
-    return m_cached_characteristic->getTurnTimeResetSteer();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::TURN_TIME_RESET_STEER);
 }  // getTurnTimeResetSteer
 
 // ----------------------------------------------------------------------------
-InterpolationArray KartProperties::getTurnTimeFullSteer() const
+const InterpolationArray& KartProperties::getTurnTimeFullSteer() const
 {
-    return m_cached_characteristic->getTurnTimeFullSteer();
+    return m_compiled_characteristic.getInterpolationArray(
+        AbstractCharacteristic::TURN_TIME_FULL_STEER);
 }  // getTurnTimeFullSteer
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEnginePower() const
 {
-    return m_cached_characteristic->getEnginePower();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ENGINE_POWER);
 }  // getEnginePower
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineMaxSpeed() const
 {
-    return m_cached_characteristic->getEngineMaxSpeed();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ENGINE_MAX_SPEED);
 }  // getEngineMaxSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineGenericMaxSpeed() const
 {
-    return m_cached_characteristic->getEngineGenericMaxSpeed();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ENGINE_GENERIC_MAX_SPEED);
 }  // getEngineMaxSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineBrakeFactor() const
 {
-    return m_cached_characteristic->getEngineBrakeFactor();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ENGINE_BRAKE_FACTOR);
 }  // getEngineBrakeFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineBrakeTimeIncrease() const
 {
-    return m_cached_characteristic->getEngineBrakeTimeIncrease();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ENGINE_BRAKE_TIME_INCREASE);
 }  // getEngineBrakeTimeIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getEngineMaxSpeedReverseRatio() const
 {
-    return m_cached_characteristic->getEngineMaxSpeedReverseRatio();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ENGINE_MAX_SPEED_REVERSE_RATIO);
 }  // getEngineMaxSpeedReverseRatio
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getGearSwitchRatio() const
+FloatSpan KartProperties::getGearSwitchRatio() const
 {
-    return m_cached_characteristic->getGearSwitchRatio();
+    return m_compiled_characteristic.getFloatVector(
+        AbstractCharacteristic::GEAR_SWITCH_RATIO);
 }  // getGearSwitchRatio
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getGearPowerIncrease() const
+FloatSpan KartProperties::getGearPowerIncrease() const
 {
-    return m_cached_characteristic->getGearPowerIncrease();
+    return m_compiled_characteristic.getFloatVector(
+        AbstractCharacteristic::GEAR_POWER_INCREASE);
 }  // getGearPowerIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getMass() const
 {
-    return m_cached_characteristic->getMass();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::MASS);
 }  // getMass
 
 // ----------------------------------------------------------------------------
 float KartProperties::getWheelsDampingRelaxation() const
 {
-    return m_cached_characteristic->getWheelsDampingRelaxation();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::WHEELS_DAMPING_RELAXATION);
 }  // getWheelsDampingRelaxation
 
 // ----------------------------------------------------------------------------
 float KartProperties::getWheelsDampingCompression() const
 {
-    return m_cached_characteristic->getWheelsDampingCompression();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::WHEELS_DAMPING_COMPRESSION);
 }  // getWheelsDampingCompression
 
 // ----------------------------------------------------------------------------
 float KartProperties::getCameraDistance() const
 {
-    return m_cached_characteristic->getCameraDistance();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::CAMERA_DISTANCE);
 }  // getCameraDistance
 
 // ----------------------------------------------------------------------------
 float KartProperties::getCameraForwardUpAngle() const
 {
-    return m_cached_characteristic->getCameraForwardUpAngle();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::CAMERA_FORWARD_UP_ANGLE);
 }  // getCameraForwardUpAngle
 
 // ----------------------------------------------------------------------------
 float KartProperties::getCameraBackwardUpAngle() const
 {
-    return m_cached_characteristic->getCameraBackwardUpAngle();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::CAMERA_BACKWARD_UP_ANGLE);
 }  // getCameraBackwardUpAngle
 
 // ----------------------------------------------------------------------------
 float KartProperties::getJumpAnimationTime() const
 {
-    return m_cached_characteristic->getJumpAnimationTime();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::JUMP_ANIMATION_TIME);
 }  // getJumpAnimationTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getLeanMax() const
 {
-    return m_cached_characteristic->getLeanMax();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::LEAN_MAX);
 }  // getLeanMax
 
 // ----------------------------------------------------------------------------
 float KartProperties::getLeanSpeed() const
 {
-    return m_cached_characteristic->getLeanSpeed();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::LEAN_SPEED);
 }  // getLeanSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getAnvilDuration() const
 {
-    return m_cached_characteristic->getAnvilDuration();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ANVIL_DURATION);
 }  // getAnvilDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getAnvilWeight() const
 {
-    return m_cached_characteristic->getAnvilWeight();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ANVIL_WEIGHT);
 }  // getAnvilWeight
 
 // ----------------------------------------------------------------------------
 float KartProperties::getAnvilSpeedFactor() const
 {
-    return m_cached_characteristic->getAnvilSpeedFactor();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ANVIL_SPEED_FACTOR);
 }  // getAnvilSpeedFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteFriction() const
 {
-    return m_cached_characteristic->getParachuteFriction();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PARACHUTE_FRICTION);
 }  // getParachuteFriction
 
 // ----------------------------------------------------------------------------
 int KartProperties::getParachuteDuration() const
 {
-    return m_cached_characteristic->getParachuteDuration();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PARACHUTE_DURATION);
 }  // getParachuteDuration
 
 // ----------------------------------------------------------------------------
 int KartProperties::getParachuteDurationOther() const
 {
-    return m_cached_characteristic->getParachuteDurationOther();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PARACHUTE_DURATION_OTHER);
 }  // getParachuteDurationOther
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteDurationRankMult() const
 {
-    return m_cached_characteristic->getParachuteDurationRankMult();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PARACHUTE_DURATION_RANK_MULT);
 }  // getParachuteDurationRankMult
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteDurationSpeedMult() const
 {
-    return m_cached_characteristic->getParachuteDurationSpeedMult();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PARACHUTE_DURATION_SPEED_MULT);
 }  // getParachuteDurationSpeedMult
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteLboundFraction() const
 {
-    return m_cached_characteristic->getParachuteLboundFraction();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PARACHUTE_LBOUND_FRACTION);
 }  // getParachuteLboundFraction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteUboundFraction() const
 {
-    return m_cached_characteristic->getParachuteUboundFraction();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PARACHUTE_UBOUND_FRACTION);
 }  // getParachuteUboundFraction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getParachuteMaxSpeed() const
 {
-    return m_cached_characteristic->getParachuteMaxSpeed();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PARACHUTE_MAX_SPEED);
 }  // getParachuteMaxSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getFrictionKartFriction() const
 {
-    return m_cached_characteristic->getFrictionKartFriction();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::FRICTION_KART_FRICTION);
 }  // getFrictionKartFriction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumDuration() const
 {
-    return m_cached_characteristic->getBubblegumDuration();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::BUBBLEGUM_DURATION);
 }  // getBubblegumDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumSpeedFraction() const
 {
-    return m_cached_characteristic->getBubblegumSpeedFraction();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::BUBBLEGUM_SPEED_FRACTION);
 }  // getBubblegumSpeedFraction
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumTorque() const
 {
-    return m_cached_characteristic->getBubblegumTorque();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::BUBBLEGUM_TORQUE);
 }  // getBubblegumTorque
 
 // ----------------------------------------------------------------------------
 int KartProperties::getBubblegumFadeInTicks() const
 {
-    return stk_config->time2Ticks(m_cached_characteristic
-                                  ->getBubblegumFadeInTime());
+    return stk_config->time2Ticks(m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::BUBBLEGUM_FADE_IN_TIME));
 }  // getBubblegumFadeInTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getBubblegumShieldDuration() const
 {
-    return m_cached_characteristic->getBubblegumShieldDuration();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::BUBBLEGUM_SHIELD_DURATION);
 }  // getBubblegumShieldDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperDuration() const
 {
-    return m_cached_characteristic->getZipperDuration();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ZIPPER_DURATION);
 }  // getZipperDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperForce() const
 {
-    return m_cached_characteristic->getZipperForce();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ZIPPER_FORCE);
 }  // getZipperForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperSpeedGain() const
 {
-    return m_cached_characteristic->getZipperSpeedGain();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ZIPPER_SPEED_GAIN);
 }  // getZipperSpeedGain
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperMaxSpeedIncrease() const
 {
-    return m_cached_characteristic->getZipperMaxSpeedIncrease();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ZIPPER_MAX_SPEED_INCREASE);
 }  // getZipperMaxSpeedIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getZipperFadeOutTime() const
 {
-    return m_cached_characteristic->getZipperFadeOutTime();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::ZIPPER_FADE_OUT_TIME);
 }  // getZipperFadeOutTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSwatterDuration() const
 {
-    return m_cached_characteristic->getSwatterDuration();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SWATTER_DURATION);
 }  // getSwatterDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSwatterDistance() const
 {
-    return m_cached_characteristic->getSwatterDistance();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SWATTER_DISTANCE);
 }  // getSwatterDistance
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSwatterSquashDuration() const
 {
-    return m_cached_characteristic->getSwatterSquashDuration();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SWATTER_SQUASH_DURATION);
 }  // getSwatterSquashDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSwatterSquashSlowdown() const
 {
-    return m_cached_characteristic->getSwatterSquashSlowdown();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SWATTER_SQUASH_SLOWDOWN);
 }  // getSwatterSquashSlowdown
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandMaxLength() const
 {
-    return m_cached_characteristic->getPlungerBandMaxLength();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PLUNGER_BAND_MAX_LENGTH);
 }  // getPlungerBandMaxLength
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandForce() const
 {
-    return m_cached_characteristic->getPlungerBandForce();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PLUNGER_BAND_FORCE);
 }  // getPlungerBandForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandDuration() const
 {
-    return m_cached_characteristic->getPlungerBandDuration();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PLUNGER_BAND_DURATION);
 }  // getPlungerBandDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerBandSpeedIncrease() const
 {
-    return m_cached_characteristic->getPlungerBandSpeedIncrease();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PLUNGER_BAND_SPEED_INCREASE);
 }  // getPlungerBandSpeedIncrease
 
 // ----------------------------------------------------------------------------
 int KartProperties::getPlungerBandFadeOutTicks() const
 {
-    return stk_config->time2Ticks(m_cached_characteristic
-                                   ->getPlungerBandFadeOutTime());
+    return stk_config->time2Ticks(m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PLUNGER_BAND_FADE_OUT_TIME));
 }  // getPlungerBandFadeOutTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getPlungerInFaceTime() const
 {
-    return m_cached_characteristic->getPlungerInFaceTime();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::PLUNGER_IN_FACE_TIME);
 }  // getPlungerInFaceTime
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getStartupTime() const
+FloatSpan KartProperties::getStartupTime() const
 {
-    return m_cached_characteristic->getStartupTime();
+    return m_compiled_characteristic.getFloatVector(
+        AbstractCharacteristic::STARTUP_TIME);
 }  // getStartupTime
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getStartupBoost() const
+FloatSpan KartProperties::getStartupBoost() const
 {
-    return m_cached_characteristic->getStartupBoost();
+    return m_compiled_characteristic.getFloatVector(
+        AbstractCharacteristic::STARTUP_BOOST);
 }  // getStartupBoost
 
 // ----------------------------------------------------------------------------
 float KartProperties::getRescueDuration() const
 {
-    return m_cached_characteristic->getRescueDuration();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::RESCUE_DURATION);
 }  // getRescueDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getRescueVertOffset() const
 {
-    return m_cached_characteristic->getRescueVertOffset();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::RESCUE_VERT_OFFSET);
 }  // getRescueVertOffset
 
 // ----------------------------------------------------------------------------
 float KartProperties::getRescueHeight() const
 {
-    return m_cached_characteristic->getRescueHeight();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::RESCUE_HEIGHT);
 }  // getRescueHeight
 
 // ----------------------------------------------------------------------------
 float KartProperties::getExplosionDuration() const
 {
-    return m_cached_characteristic->getExplosionDuration();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::EXPLOSION_DURATION);
 }  // getExplosionDuration
 
 // ----------------------------------------------------------------------------
 float KartProperties::getExplosionRadius() const
 {
-    return m_cached_characteristic->getExplosionRadius();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::EXPLOSION_RADIUS);
 }  // getExplosionRadius
 
 // ----------------------------------------------------------------------------
 float KartProperties::getExplosionInvulnerabilityTime() const
 {
-    return m_cached_characteristic->getExplosionInvulnerabilityTime();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::EXPLOSION_INVULNERABILITY_TIME);
 }  // getExplosionInvulnerabilityTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroDuration() const
 {
-    return m_cached_characteristic->getNitroDuration();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::NITRO_DURATION);
 }  // getNitroDuration
 
 // ------------------------------------------------------------------------
 float KartProperties::getNitroEngineForce() const
 {
-    return m_cached_characteristic->getNitroEngineForce();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::NITRO_ENGINE_FORCE);
 }  // getNitroEngineForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroEngineMult() const
 {
-    return m_cached_characteristic->getNitroEngineMult();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::NITRO_ENGINE_MULT);
 }  // getNitroEngineMult
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroConsumption() const
 {
-    return m_cached_characteristic->getNitroConsumption();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::NITRO_CONSUMPTION);
 }  // getNitroConsumption
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroSmallContainer() const
 {
-    return m_cached_characteristic->getNitroSmallContainer();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::NITRO_SMALL_CONTAINER);
 }  // getNitroSmallContainer
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroBigContainer() const
 {
-    return m_cached_characteristic->getNitroBigContainer();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::NITRO_BIG_CONTAINER);
 }  // getNitroBigContainer
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroMaxSpeedIncrease() const
 {
-    return m_cached_characteristic->getNitroMaxSpeedIncrease();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::NITRO_MAX_SPEED_INCREASE);
 }  // getNitroMaxSpeedIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroFadeOutTime() const
 {
-    return m_cached_characteristic->getNitroFadeOutTime();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::NITRO_FADE_OUT_TIME);
 }  // getNitroFadeOutTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getNitroMax() const
 {
-    return m_cached_characteristic->getNitroMax();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::NITRO_MAX);
 }  // getNitroMax
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamDurationFactor() const
 {
-    return m_cached_characteristic->getSlipstreamDurationFactor();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SLIPSTREAM_DURATION_FACTOR);
 }  // getSlipstreamDurationFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamBaseSpeed() const
 {
-    return m_cached_characteristic->getSlipstreamBaseSpeed();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SLIPSTREAM_BASE_SPEED);
 }  // getSlipstreamBaseSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamLength() const
 {
-    return m_cached_characteristic->getSlipstreamLength();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SLIPSTREAM_LENGTH);
 }  // getSlipstreamLength
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamWidth() const
 {
-    return m_cached_characteristic->getSlipstreamWidth();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SLIPSTREAM_WIDTH);
 }  // getSlipstreamWidth
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamInnerFactor() const
 {
-    return m_cached_characteristic->getSlipstreamInnerFactor();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SLIPSTREAM_INNER_FACTOR);
 }  // getSlipstreamInnerFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamMinCollectTime() const
 {
-    return m_cached_characteristic->getSlipstreamMinCollectTime();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SLIPSTREAM_MIN_COLLECT_TIME);
 }  // getSlipstreamMinCollectTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamMaxCollectTime() const
 {
-    return m_cached_characteristic->getSlipstreamMaxCollectTime();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SLIPSTREAM_MAX_COLLECT_TIME);
 }  // getSlipstreamMaxCollectTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamAddPower() const
 {
-    return m_cached_characteristic->getSlipstreamAddPower();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SLIPSTREAM_ADD_POWER);
 }  // getSlipstreamAddPower
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamMinSpeed() const
 {
-    return m_cached_characteristic->getSlipstreamMinSpeed();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SLIPSTREAM_MIN_SPEED);
 }  // getSlipstreamMinSpeed
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSlipstreamMaxSpeedIncrease() const
 {
-    return m_cached_characteristic->getSlipstreamMaxSpeedIncrease();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SLIPSTREAM_MAX_SPEED_INCREASE);
 }  // getSlipstreamMaxSpeedIncrease
 
 // ----------------------------------------------------------------------------
 int KartProperties::getSlipstreamFadeOutTicks() const
 {
-    return stk_config->time2Ticks(m_cached_characteristic
-                                  ->getSlipstreamFadeOutTime());
+    return stk_config->time2Ticks(m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SLIPSTREAM_FADE_OUT_TIME));
 }  // getSlipstreamFadeOutTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidIncrease() const
 {
-    return m_cached_characteristic->getSkidIncrease();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SKID_INCREASE);
 }  // getSkidIncrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidDecrease() const
 {
-    return m_cached_characteristic->getSkidDecrease();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SKID_DECREASE);
 }  // getSkidDecrease
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidMax() const
 {
-    return m_cached_characteristic->getSkidMax();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SKID_MAX);
 }  // getSkidMax
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidTimeTillMax() const
 {
-    return m_cached_characteristic->getSkidTimeTillMax();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SKID_TIME_TILL_MAX);
 }  // getSkidTimeTillMax
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidVisual() const
 {
-    return m_cached_characteristic->getSkidVisual();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SKID_VISUAL);
 }  // getSkidVisual
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidVisualTime() const
 {
-    return m_cached_characteristic->getSkidVisualTime();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SKID_VISUAL_TIME);
 }  // getSkidVisualTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidRevertVisualTime() const
 {
-    return m_cached_characteristic->getSkidRevertVisualTime();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SKID_REVERT_VISUAL_TIME);
 }  // getSkidRevertVisualTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidMinSpeed() const
 {
-    return m_cached_characteristic->getSkidMinSpeed();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SKID_MIN_SPEED);
 }  // getSkidMinSpeed
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getSkidTimeTillBonus() const
+FloatSpan KartProperties::getSkidTimeTillBonus() const
 {
-    return m_cached_characteristic->getSkidTimeTillBonus();
+    return m_compiled_characteristic.getFloatVector(
+        AbstractCharacteristic::SKID_TIME_TILL_BONUS);
 }  // getSkidTimeTillBonus
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getSkidBonusSpeed() const
+FloatSpan KartProperties::getSkidBonusSpeed() const
 {
-    return m_cached_characteristic->getSkidBonusSpeed();
+    return m_compiled_characteristic.getFloatVector(
+        AbstractCharacteristic::SKID_BONUS_SPEED);
 }  // getSkidBonusSpeed
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getSkidBonusTime() const
+FloatSpan KartProperties::getSkidBonusTime() const
 {
-    return m_cached_characteristic->getSkidBonusTime();
+    return m_compiled_characteristic.getFloatVector(
+        AbstractCharacteristic::SKID_BONUS_TIME);
 }  // getSkidBonusTime
 
 // ----------------------------------------------------------------------------
-std::vector<float> KartProperties::getSkidBonusForce() const
+FloatSpan KartProperties::getSkidBonusForce() const
 {
-    return m_cached_characteristic->getSkidBonusForce();
+    return m_compiled_characteristic.getFloatVector(
+        AbstractCharacteristic::SKID_BONUS_FORCE);
 }  // getSkidBonusForce
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidPhysicalJumpTime() const
 {
-    return m_cached_characteristic->getSkidPhysicalJumpTime();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SKID_PHYSICAL_JUMP_TIME);
 }  // getSkidPhysicalJumpTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidGraphicalJumpTime() const
 {
-    return m_cached_characteristic->getSkidGraphicalJumpTime();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SKID_GRAPHICAL_JUMP_TIME);
 }  // getSkidGraphicalJumpTime
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidPostSkidRotateFactor() const
 {
-    return m_cached_characteristic->getSkidPostSkidRotateFactor();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SKID_POST_SKID_ROTATE_FACTOR);
 }  // getSkidPostSkidRotateFactor
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidReduceTurnMin() const
 {
-    return m_cached_characteristic->getSkidReduceTurnMin();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SKID_REDUCE_TURN_MIN);
 }  // getSkidReduceTurnMin
 
 // ----------------------------------------------------------------------------
 float KartProperties::getSkidReduceTurnMax() const
 {
-    return m_cached_characteristic->getSkidReduceTurnMax();
+    return m_compiled_characteristic.getFloat(
+        AbstractCharacteristic::SKID_REDUCE_TURN_MAX);
 }  // getSkidReduceTurnMax
 
 // ----------------------------------------------------------------------------
 bool KartProperties::getSkidEnabled() const
 {
-    return m_cached_characteristic->getSkidEnabled();
+    return m_compiled_characteristic.getBool(
+        AbstractCharacteristic::SKID_ENABLED);
 }  // getSkidEnabled
 
 /* <characteristics-end kpgetter> */
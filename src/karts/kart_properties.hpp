@@ -32,13 +32,13 @@ namespace irr
 using namespace irr;
 
 #include "io/xml_node.hpp"
+#include "karts/compiled_characteristic.hpp"
 #include "race/race_manager.hpp"
 #include "utils/interpolation_array.hpp"
 #include "utils/vec3.hpp"
 
 class AbstractCharacteristic;
 class AIProperties;
-class CachedCharacteristic;
 class CombinedCharacteristic;
 class KartModel;
 class Material;
@@ -121,8 +121,17 @@ private:
     std::shared_ptr<AbstractCharacteristic> m_characteristic;
     /** The base characteristics combined with the characteristics of this kart. */
     std::shared_ptr<CombinedCharacteristic> m_combined_characteristic;
-    /** The cached combined characteristics. */
-    std::shared_ptr<CachedCharacteristic> m_cached_characteristic;
+    /** The combined characteristics compiled into a flat table, which is
+     *  what all getters below read from. */
+    CompiledCharacteristic m_compiled_characteristic;
+
+    /** The turn angle (sin(1/turn radius)) at each speed, precomputed from
+     *  the turn radius characteristic. */
+    InterpolationArray m_turn_angle_at_speed;
+
+    /** The turn angle scaled by the wheel base, i.e. the maximum steer
+     *  angle at each speed. */
+    InterpolationArray m_max_steer_angle_at_speed;
 
     // Physic properties
     // -----------------
@@ -201,6 +210,7 @@ private:
     void  load              (const std::string &filename,
                              const std::string &node);
     void combineCharacteristics(PerPlayerDifficulty d);
+    void computeSteerAngles();
 
 public:
     /** Returns the string representation of a per-player difficulty. */
@@ -290,6 +300,20 @@ public:
     /** Returns the wheel base (distance front to rear axis). */
     float getWheelBase              () const {return m_wheel_base;            }
 
+    // ------------------------------------------------------------------------
+    /** Returns the turn angle at a given speed. */
+    const InterpolationArray& getTurnAngleAtSpeed() const
+    {
+        return m_turn_angle_at_speed;
+    }   // getTurnAngleAtSpeed
+
+    // ------------------------------------------------------------------------
+    /** Returns the maximum steer angle at a given speed. */
+    const InterpolationArray& getMaxSteerAngleAtSpeed() const
+    {
+        return m_max_steer_angle_at_speed;
+    }   // getMaxSteerAngleAtSpeed
+
     // ------------------------------------------------------------------------
     /** Returns a shift of the center of mass (lowering the center of mass
      *  makes the karts more stable. */
@@ -365,12 +389,12 @@ public:
     float getStabilityChassisAngularDamping() const;
     float getStabilityDownwardImpulseFactor() const;
     float getStabilityTrackConnectionAccel() const;
-    std::vector<float> getStabilityAngularFactor() const;
+    FloatSpan getStabilityAngularFactor() const;
     float getStabilitySmoothFlyingImpulse() const;
 
-    InterpolationArray getTurnRadius() const;
+    const InterpolationArray& getTurnRadius() const;
     float getTurnTimeResetSteer() const;
-    InterpolationArray getTurnTimeFullSteer() const;
+    const InterpolationArray& getTurnTimeFullSteer() const;
 
     float getEnginePower() const;
     float getEngineMaxSpeed() const;
@@ -379,8 +403,8 @@ public:
     float getEngineBrakeTimeIncrease() const;
     float getEngineMaxSpeedReverseRatio() const;
 
-    std::vector<float> getGearSwitchRatio() const;
-    std::vector<float> getGearPowerIncrease() const;
+    FloatSpan getGearSwitchRatio() const;
+    FloatSpan getGearPowerIncrease() const;
 
     float getMass() const;
 
@@ -435,8 +459,8 @@ public:
     int   getPlungerBandFadeOutTicks() const;
     float getPlungerInFaceTime() const;
 
-    std::vector<float> getStartupTime() const;
-    std::vector<float> getStartupBoost() const;
+    FloatSpan getStartupTime() const;
+    FloatSpan getStartupBoost() const;
 
     float getRescueDuration() const;
     float getRescueVertOffset() const;
@@ -475,10 +499,10 @@ public:
     float getSkidVisualTime() const;
     float getSkidRevertVisualTime() const;
     float getSkidMinSpeed() const;
-    std::vector<float> getSkidTimeTillBonus() const;
-    std::vector<float> getSkidBonusSpeed() const;
-    std::vector<float> getSkidBonusTime() const;
-    std::vector<float> getSkidBonusForce() const;
+    FloatSpan getSkidTimeTillBonus() const;
+    FloatSpan getSkidBonusSpeed() const;
+    FloatSpan getSkidBonusTime() const;
+    FloatSpan getSkidBonusForce() const;
     float getSkidPhysicalJumpTime() const;
     float getSkidGraphicalJumpTime() const;
     float getSkidPostSkidRotateFactor() const;
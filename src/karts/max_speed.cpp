@@ -22,6 +22,7 @@
 #include "karts/abstract_kart.hpp"
 #include "karts/kart_properties.hpp"
 #include "utils/log.hpp"
+#include "utils/snapshot.hpp"
 
 #include "physics/btKart.hpp"
 
@@ -84,6 +85,32 @@ void MaxSpeed::reset()
     }
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves all speed increases and decreases into a snapshot. */
+void MaxSpeed::saveState(Snapshot *s) const
+{
+    s->add(m_current_max_speed);
+    s->add(m_add_engine_force);
+    s->add(m_min_speed);
+    for(unsigned int i=MS_DECREASE_MIN; i<MS_DECREASE_MAX; i++)
+        s->add(m_speed_decrease[i]);
+    for(unsigned int i=MS_INCREASE_MIN; i<MS_INCREASE_MAX; i++)
+        s->add(m_speed_increase[i]);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state saved with saveState. */
+void MaxSpeed::restoreState(Snapshot *s)
+{
+    s->get(&m_current_max_speed);
+    s->get(&m_add_engine_force);
+    s->get(&m_min_speed);
+    for(unsigned int i=MS_DECREASE_MIN; i<MS_DECREASE_MAX; i++)
+        s->get(&m_speed_decrease[i]);
+    for(unsigned int i=MS_INCREASE_MIN; i<MS_INCREASE_MAX; i++)
+        s->get(&m_speed_increase[i]);
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Sets an increased maximum speed for a category.
  *  \param category The category for which to set the higher maximum speed.
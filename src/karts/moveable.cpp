@@ -26,6 +26,7 @@
 #include "graphics/material_manager.hpp"
 #include "modes/world.hpp"
 #include "tracks/track.hpp"
+#include "utils/snapshot.hpp"
 
 #include "ISceneNode.h"
 
@@ -197,3 +198,45 @@ void Moveable::setTrans(const btTransform &t)
     if(m_motion_state)
         m_motion_state->setWorldTransform(t);
 }   // setTrans
+
+//-----------------------------------------------------------------------------
+/** Saves the transform and velocities of this moveable and its rigid body
+ *  into a snapshot.
+ */
+void Moveable::saveState(Snapshot *s) const
+{
+    s->add(m_transform);
+    s->add(m_velocityLC);
+    if (!m_body)
+        return;
+    s->add(m_body->getWorldTransform());
+    s->add(m_body->getInterpolationWorldTransform());
+    s->add(m_body->getLinearVelocity());
+    s->add(m_body->getAngularVelocity());
+    s->add(m_body->getInterpolationLinearVelocity());
+    s->add(m_body->getInterpolationAngularVelocity());
+    s->add(m_body->getGravity());
+    s->add(m_body->getLinearDamping());
+    s->add(m_body->getAngularDamping());
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the state saved with saveState. */
+void Moveable::restoreState(Snapshot *s)
+{
+    setTrans(s->get<btTransform>());
+    s->get(&m_velocityLC);
+    updatePosition();
+    if (!m_body)
+        return;
+    m_body->setWorldTransform(s->get<btTransform>());
+    m_body->setInterpolationWorldTransform(s->get<btTransform>());
+    m_body->setLinearVelocity(s->get<btVector3>());
+    m_body->setAngularVelocity(s->get<btVector3>());
+    m_body->setInterpolationLinearVelocity(s->get<btVector3>());
+    m_body->setInterpolationAngularVelocity(s->get<btVector3>());
+    m_body->setGravity(s->get<btVector3>());
+    btScalar linear_damping = s->get<btScalar>();
+    m_body->setDamping(linear_damping, s->get<btScalar>());
+    m_body->activate();
+}   // restoreState
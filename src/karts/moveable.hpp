@@ -36,6 +36,7 @@ using namespace irr;
 #include <string>
 
 class Material;
+class Snapshot;
 
 /**
   * \ingroup karts
@@ -123,6 +124,8 @@ public:
                  &getTrans() const {return m_transform;}
     void          setTrans(const btTransform& t);
     void          updatePosition();
+    virtual void  saveState(Snapshot *s) const;
+    virtual void  restoreState(Snapshot *s);
     // ------------------------------------------------------------------------
     /** Called once per rendered frame. It is used to only update any graphical
      *  effects.
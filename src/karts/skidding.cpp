@@ -31,6 +31,7 @@
 #include "physics/btKart.hpp"
 #include "tracks/track.hpp"
 #include "utils/log.hpp"
+#include "utils/snapshot.hpp"
 
 /** Constructor of the skidding object.
  */
@@ -86,6 +87,42 @@ void Skidding::reset()
     m_kart->getVehicle()->setTimedRotation(0, 0);
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the skidding state into a snapshot (see World::saveState). */
+void Skidding::saveState(Snapshot *s) const
+{
+    s->add(m_skid_time);
+    s->add(m_skid_state);
+    s->add(m_skid_factor);
+    s->add(m_real_steering);
+    s->add(m_visual_rotation);
+    s->add(m_skid_bonus_ready);
+    s->add(m_remaining_jump_time);
+    s->add(m_prev_visual_rotation);
+    s->add(m_graphical_remaining_jump_time);
+    s->add(m_smoothing_time);
+    s->add(m_smoothing_dt);
+    s->add(m_skid_bonus_end_ticks);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the skidding state saved with saveState. */
+void Skidding::restoreState(Snapshot *s)
+{
+    s->get(&m_skid_time);
+    s->get(&m_skid_state);
+    s->get(&m_skid_factor);
+    s->get(&m_real_steering);
+    s->get(&m_visual_rotation);
+    s->get(&m_skid_bonus_ready);
+    s->get(&m_remaining_jump_time);
+    s->get(&m_prev_visual_rotation);
+    s->get(&m_graphical_remaining_jump_time);
+    s->get(&m_smoothing_time);
+    s->get(&m_smoothing_dt);
+    s->get(&m_skid_bonus_end_ticks);
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Computes the actual steering fraction to be used in the physics, and
  *  stores it in m_real_skidding. This is later used by kart to set the
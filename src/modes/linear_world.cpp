@@ -31,6 +31,7 @@
 #include "tracks/track_sector.hpp"
 #include "tracks/track.hpp"
 #include "utils/constants.hpp"
+#include "utils/snapshot.hpp"
 #include "utils/string_utils.hpp"
 
 #include <climits>
@@ -136,6 +137,22 @@ void LinearWorld::reset(bool restart)
 
 }   // reset
 
+//-----------------------------------------------------------------------------
+void LinearWorld::saveState(Snapshot *s) const
+{
+    WorldWithRank::saveState(s);
+    s->add(m_fastest_lap_ticks);
+    s->add(m_kart_info);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+void LinearWorld::restoreState(Snapshot *s)
+{
+    WorldWithRank::restoreState(s);
+    s->get(&m_fastest_lap_ticks);
+    s->get(&m_kart_info);
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** General update function called once per frame. This updates the kart
  *  sectors, which are then used to determine the kart positions.
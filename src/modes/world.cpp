@@ -26,8 +26,11 @@
 #include "graphics/material.hpp"
 #include "graphics/material_manager.hpp"
 #include "graphics/render_info.hpp"
+#include "graphics/sp/sp_texture_manager.hpp"
 #include "io/file_manager.hpp"
 #include "input/input.hpp"
+#include "items/item_manager.hpp"
+#include "items/powerup_manager.hpp"
 #include "items/projectile_manager.hpp"
 #include "karts/controller/battle_ai.hpp"
 #include "karts/controller/end_controller.hpp"
@@ -43,6 +46,7 @@
 #include "physics/triangle_mesh.hpp"
 #include "race/race_manager.hpp"
 #include "scriptengine/script_engine.hpp"
+#include "scriptengine/script_utils.hpp"
 #include "tracks/check_manager.hpp"
 #include "tracks/track.hpp"
 #include "tracks/track_manager.hpp"
@@ -50,7 +54,10 @@
 #include "tracks/track_object_manager.hpp"
 #include "utils/constants.hpp"
 #include "utils/profiler.hpp"
+#include "utils/random_generator.hpp"
+#include "utils/snapshot.hpp"
 #include "utils/string_utils.hpp"
+#include "utils/worker_pool.hpp"
 
 #include <algorithm>
 #include <assert.h>
@@ -150,6 +157,12 @@ void World::init()
     unsigned int num_karts = race_manager->getNumberOfKarts();
     //assert(num_karts > 0);
 
+#ifndef SERVER_ONLY
+    // Decode all textures of the track and karts together once they are
+    // loaded (at the end of this function), see SPTextureManager::endBatch
+    SP::SPTextureManager::ScopedBatch texture_batch;
+#endif
+
     // Load the track models - this must be done before the karts so that the
     // karts can be positioned properly on (and not in) the tracks.
     // This also defines the static Track::getCurrentTrack function.
@@ -236,6 +249,15 @@ void World::initTeamArrows(AbstractKart* k)
 void World::reset(bool restart)
 {
     WorldStatus::reset(restart);
+    // Re-seed all random streams, so that a restarted race with the same
+    // seed and actions is identical to the first one.
+    const uint32_t seed = race_manager->getRandomSeed();
+    ItemManager::updateRandomSeed(
+        RandomGenerator::deriveSeed(seed, RandomGenerator::RS_ITEMS));
+    powerup_manager->setRandomSeed(
+        RandomGenerator::deriveSeed(seed, RandomGenerator::RS_POWERUPS));
+    Scripting::Utils::scripting_random.seed(
+        RandomGenerator::deriveSeed(seed, RandomGenerator::RS_SCRIPT));
     m_faster_music_active = false;
     m_eliminated_karts    = 0;
     m_eliminated_players  = 0;
@@ -264,6 +286,57 @@ void World::reset(bool restart)
     m_unfair_team = false;
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the simulation state of the world (race clock, karts, items,
+ *  projectiles, check structures and moving track objects) into a snapshot,
+ *  which can be used to rewind the world with restoreState. Graphical
+ *  effects are not saved.
+ */
+void World::saveState(Snapshot *s) const
+{
+    WorldStatus::saveState(s);
+    s->add(m_eliminated_karts);
+    s->add(m_eliminated_players);
+    s->add(Scripting::Utils::scripting_random);
+    race_manager->saveState(s);
+    // Projectiles are restored before the karts, see restoreState
+    projectile_manager->saveState(s);
+    for (unsigned int i = 0; i < m_karts.size(); i++)
+        m_karts[i]->saveState(s);
+    ItemManager::get()->saveState(s);
+    if (CheckManager::get())
+        CheckManager::get()->saveState(s);
+    Track::getCurrentTrack()->getTrackObjectManager()->saveState(s);
+    // Controllers refer to items, so they are restored after them
+    for (unsigned int i = 0; i < m_karts.size(); i++)
+        m_karts[i]->getController()->saveState(s);
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the world state saved with saveState. The snapshot must have been
+ *  created by this world.
+ */
+void World::restoreState(Snapshot *s)
+{
+    WorldStatus::restoreState(s);
+    s->get(&m_eliminated_karts);
+    s->get(&m_eliminated_players);
+    s->get(&Scripting::Utils::scripting_random);
+    race_manager->restoreState(s);
+    // Re-firing a projectile can affect other karts (e.g. a rubber band
+    // hitting a shield), so the karts are restored after the projectiles
+    projectile_manager->restoreState(s);
+    for (unsigned int i = 0; i < m_karts.size(); i++)
+        m_karts[i]->restoreState(s);
+    ItemManager::get()->restoreState(s);
+    if (CheckManager::get())
+        CheckManager::get()->restoreState(s);
+    Track::getCurrentTrack()->getTrackObjectManager()->restoreState(s);
+    for (unsigned int i = 0; i < m_karts.size(); i++)
+        m_karts[i]->getController()->restoreState(s);
+    Physics::getInstance()->clearContactCache();
+}   // restoreState
+
 
 //-----------------------------------------------------------------------------
 /** Creates a kart, having a certain position, starting location, and local
@@ -644,6 +717,12 @@ void World::updateGraphics(float dt)
     Track::getCurrentTrack()->updateGraphics(dt);
 }   // updateGraphics
 
+//-----------------------------------------------------------------------------
+/** Updates only what is needed between steps without rendering. The cameras
+ *  are updated even in physics only mode, since the world state exposes
+ *  their view and projection. The scripts always have to run, since their
+ *  timeouts can change the race.
+ */
 void World::updateGraphicsMinimal(float dt)
 {
     PROFILER_PUSH_CPU_MARKER("World::updateGraphics (camera)", 0x60, 0x7F, 0);
@@ -679,10 +758,27 @@ void World::update(int ticks)
 
     PROFILER_PUSH_CPU_MARKER("World::update (Kart::upate)", 0x40, 0x7F, 0x00);
 
+    const int kart_amount = (int)m_karts.size();
+
+    // If enabled, do the expensive read-only queries of all karts (terrain
+    // raycasts, AI look-ahead) in parallel first. The karts only use these
+    // results if their inputs did not change in the following serial
+    // update, so the simulation does not depend on the number of threads.
+    WorkerPool *worker_pool = WorkerPool::get();
+    if (worker_pool && kart_amount > 1)
+    {
+        PROFILER_PUSH_CPU_MARKER("World::update (Kart::prepareUpdate)", 0x40, 0x7F, 0x40);
+        worker_pool->parallelFor(kart_amount, [this, ticks](unsigned int i)
+            {
+                if (!m_karts[i]->isEliminated())
+                    m_karts[i]->prepareUpdate(ticks);
+            });
+        PROFILER_POP_CPU_MARKER();
+    }
+
     // Update all the karts. This in turn will also update the controller,
     // which causes all AI steering commands set. So in the following 
     // physics update the new steering is taken into account.
-    const int kart_amount = (int)m_karts.size();
     for (int i = 0 ; i < kart_amount; ++i)
     {
         SpareTireAI* sta =
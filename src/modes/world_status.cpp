@@ -22,6 +22,7 @@
 #include "karts/abstract_kart.hpp"
 #include "modes/world.hpp"
 #include "tracks/track.hpp"
+#include "utils/snapshot.hpp"
 
 #include <irrlicht.h>
 
@@ -59,6 +60,26 @@ void WorldStatus::reset(bool restart)
     Track::getCurrentTrack()->startMusic();
 }   // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the race clock and phase into a snapshot. */
+void WorldStatus::saveState(Snapshot *s) const
+{
+    s->add(m_time);
+    s->add(m_time_ticks);
+    s->add(m_count_up_ticks);
+    s->add(m_phase.load());
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the race clock and phase saved with saveState. */
+void WorldStatus::restoreState(Snapshot *s)
+{
+    s->get(&m_time);
+    s->get(&m_time_ticks);
+    s->get(&m_count_up_ticks);
+    m_phase = s->get<Phase>();
+}   // restoreState
+
 //-----------------------------------------------------------------------------
 /** Destructor of WorldStatus.
  */
@@ -21,6 +21,8 @@
 #include "utils/cpp2011.hpp"
 #include <atomic>
 
+class Snapshot;
+
 /**
  * \brief A class that manages the clock (countdown, chrono, etc.)
  * Also manages stuff like the 'ready/set/go' text at the beginning or the delay at the end of a race.
@@ -83,6 +85,8 @@ public:
     virtual ~WorldStatus();
 
     virtual void reset(bool restart);
+    virtual void saveState(Snapshot *s) const;
+    virtual void restoreState(Snapshot *s);
     virtual void updateTime(int ticks);
     virtual void update(int ticks);
     void         startReadySetGo();
@@ -75,6 +75,8 @@ public:
         results will be incorrect */
     virtual void  init() OVERRIDE;
     virtual void  reset(bool restart=false) OVERRIDE;
+    virtual void  saveState(Snapshot *s) const OVERRIDE;
+    virtual void  restoreState(Snapshot *s) OVERRIDE;
 
     bool          displayRank() const { return m_display_rank; }
 
@@ -29,6 +29,7 @@
 #include "physics/triangle_mesh.hpp"
 #include "tracks/terrain_info.hpp"
 #include "tracks/track.hpp"
+#include "utils/snapshot.hpp"
 
 #define ROLLING_INFLUENCE_FIX
 
@@ -1030,4 +1031,109 @@ btScalar btKart::rayCast(btWheelInfo& wheel, const btVector3& ray)
 }   // rayCast(btWheelInfo& wheel, const btVector3& ray
 
 // ----------------------------------------------------------------------------
+/** Saves the simulation state of a wheel. The fields are stored one by one,
+ *  since btWheelInfo also contains pointers (ground object and client info)
+ *  which must not be copied into a snapshot.
+ */
+static void saveWheelInfo(Snapshot *s, const btWheelInfo &wheel)
+{
+    const btWheelInfo::RaycastInfo &ri = wheel.m_raycastInfo;
+    s->add(ri.m_contactNormalWS);
+    s->add(ri.m_contactPointWS);
+    s->add(ri.m_suspensionLength);
+    s->add(ri.m_hardPointWS);
+    s->add(ri.m_wheelDirectionWS);
+    s->add(ri.m_wheelAxleWS);
+    s->add(ri.m_isInContact);
+    s->add(ri.m_triangle_index);
+    s->add(wheel.m_worldTransform);
+    s->add(wheel.m_wheelAxleCS);
+    s->add(wheel.m_frictionSlip);
+    s->add(wheel.m_steering);
+    s->add(wheel.m_engineForce);
+    s->add(wheel.m_brake);
+    s->add(wheel.m_was_on_ground);
+    s->add(wheel.m_clippedInvContactDotSuspension);
+    s->add(wheel.m_suspensionRelativeVelocity);
+    s->add(wheel.m_wheelsSuspensionForce);
+    s->add(wheel.m_skidInfo);
+}   // saveWheelInfo
+
+// ----------------------------------------------------------------------------
+/** Restores a wheel saved with saveWheelInfo. The ground object is reset, it
+ *  is set again by the next raycast.
+ */
+static void restoreWheelInfo(Snapshot *s, btWheelInfo *wheel)
+{
+    btWheelInfo::RaycastInfo &ri = wheel->m_raycastInfo;
+    s->get(&ri.m_contactNormalWS);
+    s->get(&ri.m_contactPointWS);
+    s->get(&ri.m_suspensionLength);
+    s->get(&ri.m_hardPointWS);
+    s->get(&ri.m_wheelDirectionWS);
+    s->get(&ri.m_wheelAxleWS);
+    s->get(&ri.m_isInContact);
+    s->get(&ri.m_triangle_index);
+    ri.m_groundObject = NULL;
+    s->get(&wheel->m_worldTransform);
+    s->get(&wheel->m_wheelAxleCS);
+    s->get(&wheel->m_frictionSlip);
+    s->get(&wheel->m_steering);
+    s->get(&wheel->m_engineForce);
+    s->get(&wheel->m_brake);
+    s->get(&wheel->m_was_on_ground);
+    s->get(&wheel->m_clippedInvContactDotSuspension);
+    s->get(&wheel->m_suspensionRelativeVelocity);
+    s->get(&wheel->m_wheelsSuspensionForce);
+    s->get(&wheel->m_skidInfo);
+}   // restoreWheelInfo
+
+// ----------------------------------------------------------------------------
+/** Saves the state of the vehicle (wheels, impulses and speed limits) into
+ *  a snapshot. The chassis body itself is saved by the kart.
+ */
+void btKart::saveState(Snapshot *s) const
+{
+    for (int i = 0; i < getNumWheels(); i++)
+    {
+        saveWheelInfo(s, m_wheelInfo[i]);
+        s->add(m_forwardWS[i]);
+        s->add(m_axle[i]);
+        s->add(m_forwardImpulse[i]);
+        s->add(m_sideImpulse[i]);
+    }
+    s->add(m_allow_sliding);
+    s->add(m_additional_impulse);
+    s->add(m_ticks_additional_impulse);
+    s->add(m_additional_rotation);
+    s->add(m_ticks_additional_rotation);
+    s->add(m_num_wheels_on_ground);
+    s->add(m_min_speed);
+    s->add(m_max_speed);
+    s->add(m_visual_wheels_touch_ground);
+}   // saveState
 
+// ----------------------------------------------------------------------------
+/** Restores the state saved with saveState. */
+void btKart::restoreState(Snapshot *s)
+{
+    for (int i = 0; i < getNumWheels(); i++)
+    {
+        restoreWheelInfo(s, &m_wheelInfo[i]);
+        s->get(&m_forwardWS[i]);
+        s->get(&m_axle[i]);
+        s->get(&m_forwardImpulse[i]);
+        s->get(&m_sideImpulse[i]);
+    }
+    s->get(&m_allow_sliding);
+    s->get(&m_additional_impulse);
+    s->get(&m_ticks_additional_impulse);
+    s->get(&m_additional_rotation);
+    s->get(&m_ticks_additional_rotation);
+    s->get(&m_num_wheels_on_ground);
+    s->get(&m_min_speed);
+    s->get(&m_max_speed);
+    s->get(&m_visual_wheels_touch_ground);
+}   // restoreState
+
+// ----------------------------------------------------------------------------
@@ -23,6 +23,7 @@ class btDynamicsWorld;
 
 class btVehicleTuning;
 class Kart;
+class Snapshot;
 struct btWheelContactPoint;
 
 /** rayCast vehicle, very special constraint that turn a rigidbody into a
@@ -171,6 +172,8 @@ public:
     void               updateAllWheelPositions();
     void               getVisualContactPoint(const btTransform& chassis_trans,
                                              btVector3 *left, btVector3 *right);
+    void               saveState(Snapshot *s) const;
+    void               restoreState(Snapshot *s);
         // ------------------------------------------------------------------------
     /** Returns true if both rear visual wheels touch the ground. */
     bool visualWheelsTouchGround() const
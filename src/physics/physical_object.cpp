@@ -29,10 +29,12 @@
 #include "io/xml_node.hpp"
 #include "physics/physics.hpp"
 #include "physics/triangle_mesh.hpp"
+#include "scriptengine/script_engine.hpp"
 #include "tracks/track.hpp"
 #include "tracks/track_object.hpp"
 #include "utils/constants.hpp"
 #include "utils/mini_glm.hpp"
+#include "utils/snapshot.hpp"
 #include "utils/string_utils.hpp"
 #include "utils/mini_glm.hpp"
 
@@ -165,6 +167,9 @@ PhysicalObject::PhysicalObject(bool is_dynamic,
     m_reset_height       = settings.m_reset_height;
     m_on_kart_collision  = settings.m_on_kart_collision;
     m_on_item_collision  = settings.m_on_item_collision;
+    m_on_kart_collision_script = NULL;
+    m_on_item_collision_script = NULL;
+    m_scripts_resolved   = false;
     m_current_transform.setOrigin(Vec3());
     m_current_transform.setRotation(
         btQuaternion(0.0f, 0.0f, 0.0f, 1.0f));
@@ -188,6 +193,31 @@ PhysicalObject::PhysicalObject(bool is_dynamic,
     init(settings);
 }   // PhysicalObject
 
+// ----------------------------------------------------------------------------
+/** Looks up the collision callbacks of this object in the track script, so
+ *  that collisions don't need to build and look up the declarations. This
+ *  must be called after the track scripts are compiled, which is the case
+ *  once the world is ready.
+ */
+void PhysicalObject::resolveScripts()
+{
+    Scripting::ScriptEngine* script_engine =
+                                        Scripting::ScriptEngine::getInstance();
+    m_on_kart_collision_script = NULL;
+    m_on_item_collision_script = NULL;
+    if (m_on_kart_collision.size() > 0)
+    {
+        m_on_kart_collision_script = script_engine->getFunction(true,
+            "void " + m_on_kart_collision + "(int, const string, const string)");
+    }
+    if (m_on_item_collision.size() > 0)
+    {
+        m_on_item_collision_script = script_engine->getFunction(true,
+            "void " + m_on_item_collision + "(int, int, const string)");
+    }
+    m_scripts_resolved = true;
+}   // resolveScripts
+
 // ----------------------------------------------------------------------------
 PhysicalObject::~PhysicalObject()
 {
@@ -682,6 +712,41 @@ void PhysicalObject::reset()
     m_last_lv = m_last_av = Vec3(0.0f);
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the rigid body state of a dynamic object into a snapshot. Static
+ *  objects only move by animations, which are saved separately.
+ */
+void PhysicalObject::saveState(Snapshot *s) const
+{
+    if (!m_is_dynamic)
+        return;
+    s->add(m_body->getCenterOfMassTransform());
+    s->add(m_body->getLinearVelocity());
+    s->add(m_body->getAngularVelocity());
+    s->add(m_current_transform);
+    s->add(m_last_transform);
+    s->add(m_last_lv);
+    s->add(m_last_av);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state saved with saveState. */
+void PhysicalObject::restoreState(Snapshot *s)
+{
+    if (!m_is_dynamic)
+        return;
+    btTransform t = s->get<btTransform>();
+    m_body->setCenterOfMassTransform(t);
+    m_motion_state->setWorldTransform(t);
+    m_body->setLinearVelocity(s->get<btVector3>());
+    m_body->setAngularVelocity(s->get<btVector3>());
+    m_body->activate();
+    s->get(&m_current_transform);
+    s->get(&m_last_transform);
+    s->get(&m_last_lv);
+    s->get(&m_last_av);
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 void PhysicalObject::handleExplosion(const Vec3& pos, bool direct_hit)
 {
@@ -30,7 +30,9 @@
 #include "utils/leak_check.hpp"
 
 
+class asIScriptFunction;
 class Material;
+class Snapshot;
 class TrackObject;
 class XMLNode;
 
@@ -179,6 +181,14 @@ private:
     * when a (flyable) item collides with this object
     */
     std::string           m_on_item_collision;
+
+    /** The script functions for m_on_kart_collision and m_on_item_collision,
+     *  resolved once when the track scripts are available (NULL if there is
+     *  no such function). */
+    asIScriptFunction    *m_on_kart_collision_script;
+    asIScriptFunction    *m_on_item_collision_script;
+    bool                  m_scripts_resolved;
+
     /** If this body is a bullet dynamic body, i.e. affected by physics
      *  or not (static (not moving) or kinematic (animated outside
      *  of physics). */
@@ -205,11 +215,14 @@ public:
 
     virtual     ~PhysicalObject ();
     virtual void reset          ();
+    void         saveState      (Snapshot *s) const;
+    void         restoreState   (Snapshot *s);
     virtual void handleExplosion(const Vec3& pos, bool directHit);
     void         update         (float dt);
     void         updateGraphics (float dt);
     void         init           (const Settings &settings);
     void         move           (const Vec3& xyz, const core::vector3df& hpr);
+    void         resolveScripts ();
     void         hit            (const Material *m, const Vec3 &normal);
     bool         isSoccerBall   () const;
     bool castRay(const btVector3 &from,
@@ -251,6 +264,20 @@ public:
     // ------------------------------------------------------------------------
     const std::string& getOnItemCollisionFunction() const { return m_on_item_collision; }
     // ------------------------------------------------------------------------
+    /** Returns the script function to call when a kart hits this object. */
+    asIScriptFunction* getOnKartCollisionScript()
+    {
+        if (!m_scripts_resolved) resolveScripts();
+        return m_on_kart_collision_script;
+    }   // getOnKartCollisionScript
+    // ------------------------------------------------------------------------
+    /** Returns the script function to call when an item hits this object. */
+    asIScriptFunction* getOnItemCollisionScript()
+    {
+        if (!m_scripts_resolved) resolveScripts();
+        return m_on_item_collision_script;
+    }   // getOnItemCollisionScript
+    // ------------------------------------------------------------------------
     TrackObject* getTrackObject() { return m_object; }
 
     // Methods usable by scripts
@@ -141,6 +141,27 @@ void Physics::removeKart(const AbstractKart *kart)
     }
 }   // removeKart
 
+//-----------------------------------------------------------------------------
+/** Removes all cached contact manifolds. Bullet warm-starts the solver from
+ *  the contacts of the previous step, so this is called when saving or
+ *  restoring the world state: a restored world then continues exactly like
+ *  the world at the time the state was saved.
+ */
+void Physics::clearContactCache()
+{
+    btOverlappingPairCache *cache =
+        m_dynamics_world->getBroadphase()->getOverlappingPairCache();
+    btCollisionObjectArray &objects = m_dynamics_world->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); i++)
+    {
+        if (objects[i]->getBroadphaseHandle())
+        {
+            cache->cleanProxyFromPairs(objects[i]->getBroadphaseHandle(),
+                                       m_dynamics_world->getDispatcher());
+        }
+    }
+}   // clearContactCache
+
 //-----------------------------------------------------------------------------
 /** Updates the physics simulation and handles all collisions.
  *  \param ticks Number of physics steps to simulate.
@@ -181,13 +202,18 @@ void Physics::update(int ticks)
                               p->getContactPointCS(1)                );
             Scripting::ScriptEngine* script_engine =
                                             Scripting::ScriptEngine::getInstance();
-            int kartid1 = p->getUserPointer(0)->getPointerKart()->getWorldKartId();
-            int kartid2 = p->getUserPointer(1)->getPointerKart()->getWorldKartId();
-            script_engine->runFunction(false, "void onKartKartCollision(int, int)",
-                [=](asIScriptContext* ctx) {
-                    ctx->SetArgDWord(0, kartid1);
-                    ctx->SetArgDWord(1, kartid2);
-                });
+            asIScriptFunction* on_collision =
+                                script_engine->getKartKartCollisionFunction();
+            if (on_collision)
+            {
+                int kartid1 = p->getUserPointer(0)->getPointerKart()->getWorldKartId();
+                int kartid2 = p->getUserPointer(1)->getPointerKart()->getWorldKartId();
+                script_engine->executeFunction(on_collision,
+                    [=](asIScriptContext* ctx) {
+                        ctx->SetArgDWord(0, kartid1);
+                        ctx->SetArgDWord(1, kartid2);
+                    });
+            }
             continue;
         }  // if kart-kart collision
 
@@ -199,20 +225,20 @@ void Physics::update(int ticks)
             AbstractKart *kart = p->getUserPointer(1)->getPointerKart();
             int kartId = kart->getWorldKartId();
             PhysicalObject* obj = p->getUserPointer(0)->getPointerPhysicalObject();
-            std::string obj_id = obj->getID();
-            std::string scripting_function = obj->getOnKartCollisionFunction();
-
-            TrackObject* to = obj->getTrackObject();
-            TrackObject* library = to->getParentLibrary();
-            std::string lib_id;
-            std::string* lib_id_ptr = NULL;
-            if (library != NULL)
-                lib_id = library->getID();
-            lib_id_ptr = &lib_id;
-
-            if (scripting_function.size() > 0)
+            asIScriptFunction* on_collision = obj->getOnKartCollisionScript();
+
+            if (on_collision)
             {
-                script_engine->runFunction(true, "void " + scripting_function + "(int, const string, const string)",
+                std::string obj_id = obj->getID();
+                TrackObject* to = obj->getTrackObject();
+                TrackObject* library = to->getParentLibrary();
+                std::string lib_id;
+                std::string* lib_id_ptr = NULL;
+                if (library != NULL)
+                    lib_id = library->getID();
+                lib_id_ptr = &lib_id;
+
+                script_engine->executeFunction(on_collision,
                     [&](asIScriptContext* ctx) {
                         ctx->SetArgDWord(0, kartId);
                         ctx->SetArgObject(1, lib_id_ptr);
@@ -301,11 +327,11 @@ void Physics::update(int ticks)
             Scripting::ScriptEngine* script_engine = Scripting::ScriptEngine::getInstance();
             Flyable* flyable = p->getUserPointer(0)->getPointerFlyable();
             PhysicalObject* obj = p->getUserPointer(1)->getPointerPhysicalObject();
-            std::string obj_id = obj->getID();
-            std::string scripting_function = obj->getOnItemCollisionFunction();
-            if (scripting_function.size() > 0)
+            asIScriptFunction* on_collision = obj->getOnItemCollisionScript();
+            if (on_collision)
             {
-                script_engine->runFunction(true, "void " + scripting_function + "(int, int, const string)",
+                std::string obj_id = obj->getID();
+                script_engine->executeFunction(on_collision,
                         [&](asIScriptContext* ctx) {
                         ctx->SetArgDWord(0, (int)flyable->getType());
                         ctx->SetArgDWord(1, flyable->getOwnerId());
@@ -24,6 +24,7 @@
   * Contains various physics utilities.
   */
 
+#include <algorithm>
 #include <set>
 #include <vector>
 
@@ -51,10 +52,11 @@ private:
      *  duplicates. To handle this, all collisions (i.e. pair of objects)
      *  are stored in a vector, but only one entry per collision pair
      *  of objects.
-     *  While this is a natural application of std::set, the set has some
-     *  overhead (since it will likely use a tree to sort the entries).
-     *  Considering that the number of collisions is usually rather small
-     *  a simple list and linear search is faster is is being used here. */
+     *  The pairs are kept in a vector so that they are handled in the order
+     *  in which bullet reported them, and an open-addressing hash table of
+     *  indices into this vector is used to detect duplicates. With many
+     *  karts and items a linear search becomes quadratic in the number of
+     *  collisions per tick. */
     class CollisionPair
     {
     private:
@@ -109,14 +111,65 @@ private:
     class CollisionList : public std::vector<CollisionPair>
     {
     private:
-        void push_back(CollisionPair p) {
-            // only add a pair if it's not already in there
-            for(iterator i=begin(); i!=end(); i++) {
-                if((*i)==p) return;
+        /** Open-addressing hash table (linear probing) of indices into the
+         *  vector, -1 marks an empty slot. The size is always a power of
+         *  two and at least twice the number of pairs. */
+        std::vector<int> m_slots;
+        // --------------------------------------------------------------------
+        static size_t hash(const CollisionPair &p)
+        {
+            size_t h = (size_t)p.getUserPointer(0) * (size_t)0x9e3779b97f4a7c15ULL;
+            h ^= (size_t)p.getUserPointer(1) + 0x7f4a7c15 + (h << 6) + (h >> 2);
+            return h ^ (h >> 17);
+        }   // hash
+        // --------------------------------------------------------------------
+        /** Returns the slot that contains the pair, or the empty slot in
+         *  which it would have to be inserted. */
+        size_t findSlot(const CollisionPair &p) const
+        {
+            const size_t mask = m_slots.size() - 1;
+            size_t i = hash(p) & mask;
+            while (m_slots[i] != -1)
+            {
+                const CollisionPair &q = (*this)[m_slots[i]];
+                if (q.getUserPointer(0) == p.getUserPointer(0) &&
+                    q.getUserPointer(1) == p.getUserPointer(1))
+                    return i;
+                i = (i + 1) & mask;
             }
+            return i;
+        }   // findSlot
+        // --------------------------------------------------------------------
+        /** Doubles the size of the hash table and re-inserts all pairs. */
+        void grow()
+        {
+            m_slots.assign(m_slots.size() * 2, -1);
+            for (unsigned int n = 0; n < size(); n++)
+                m_slots[findSlot((*this)[n])] = n;
+        }   // grow
+        // --------------------------------------------------------------------
+        void push_back(const CollisionPair &p) {
+            // only add a pair if it's not already in there
+            size_t slot = findSlot(p);
+            if (m_slots[slot] != -1) return;
+            m_slots[slot] = (int)size();
             std::vector<CollisionPair>::push_back(p);
+            if (size() * 2 > m_slots.size())
+                grow();
         };  // push_back
     public:
+        CollisionList() : m_slots(64, -1) {}
+        // --------------------------------------------------------------------
+        /** Removes all pairs. The memory of the vector and the hash table is
+         *  kept, so that clearing the list each physics tick doesn't
+         *  allocate. */
+        void clear()
+        {
+            if (!empty())
+                std::fill(m_slots.begin(), m_slots.end(), -1);
+            std::vector<CollisionPair>::clear();
+        }   // clear
+        // --------------------------------------------------------------------
         /** Adds information about a collision to this vector. */
         void push_back(const UserPointer *a, const btVector3 &contact_point_a,
                        const UserPointer *b, const btVector3 &contact_point_b)
@@ -165,6 +218,7 @@ public:
     void  addBody          (btRigidBody* b) {m_dynamics_world->addRigidBody(b);}
     void  removeKart       (const AbstractKart *k);
     void  removeBody       (btRigidBody* b) {m_dynamics_world->removeRigidBody(b);}
+    void  clearContactCache();
     void  KartKartCollision(AbstractKart *ka, const Vec3 &contact_point_a,
                             AbstractKart *kb, const Vec3 &contact_point_b);
     void  update           (int ticks);
@@ -21,10 +21,12 @@
 #include "config/stk_config.hpp"
 #include "physics/physics.hpp"
 #include "utils/constants.hpp"
+#include "utils/file_utils.hpp"
 #include "utils/time.hpp"
 
 #include "btBulletDynamicsCommon.h"
 
+#include <cstring>
 #include <fstream>
 
 // -----------------------------------------------------------------------------
@@ -43,6 +45,7 @@ TriangleMesh::TriangleMesh(bool can_be_transformed) : m_mesh()
     // (and m_mesh->m_weldingThreshold at m_normals
     m_collision_shape  = NULL;
     m_collision_object = NULL;
+    m_bvh_buffer       = NULL;
     m_user_pointer.set(this);
 }   // TriangleMesh
 
@@ -91,7 +94,9 @@ void TriangleMesh::addTriangle(const btVector3 &t1, const btVector3 &t2,
  *  @param serialized_bhv if non-null, load the serialized bhv from file instead
  *                        of builing it on the fly
  */
-void TriangleMesh::createCollisionShape(bool create_collision_object, const char* serialized_bhv)
+void TriangleMesh::createCollisionShape(bool create_collision_object,
+                                        const char* serialized_bhv,
+                                        const std::string *bvh_data)
 {
     if(m_triangleIndex2Material.size()==0)
     {
@@ -103,54 +108,53 @@ void TriangleMesh::createCollisionShape(bool create_collision_object, const char
     }
     // Now convert the triangle mesh into a static rigid body
     btBvhTriangleMeshShape* bhv_triangle_mesh;
+    btOptimizedBvh* bhv = NULL;
 
-    if (serialized_bhv != NULL)
+    if (serialized_bhv != NULL || bvh_data != NULL)
     {
-        FILE *f = fopen(serialized_bhv, "rb");
-        fseek(f, 0, SEEK_END);
-        long pos = ftell(f);
-        assert(pos != -1L);
-        fseek(f, 0, SEEK_SET);
-
-        void* bytes = btAlignedAlloc(pos, 16);
-        fread(bytes, pos, 1, f);
-        fclose(f);
-
-        btOptimizedBvh* bhv = btOptimizedBvh::deSerializeInPlace(bytes, pos, !IS_LITTLE_ENDIAN);
-        if (bhv == NULL)
+        assert(m_bvh_buffer == NULL);
+        unsigned int size;
+        if (serialized_bhv != NULL)
         {
-            Log::warn("TriangleMesh", "Failed to load serialized BHV");
-            bhv_triangle_mesh = new btBvhTriangleMeshShape(&m_mesh, false /* useQuantizedAabbCompression */);
+            FILE *f = fopen(serialized_bhv, "rb");
+            fseek(f, 0, SEEK_END);
+            long pos = ftell(f);
+            assert(pos != -1L);
+            fseek(f, 0, SEEK_SET);
+
+            size = (unsigned int)pos;
+            m_bvh_buffer = btAlignedAlloc(size, 16);
+            fread(m_bvh_buffer, size, 1, f);
+            fclose(f);
         }
         else
         {
-            bhv_triangle_mesh = new btBvhTriangleMeshShape(&m_mesh, false /* useQuantizedAabbCompression */,
-                                                           false /* buildBvh */);
-            bhv_triangle_mesh->setOptimizedBvh( bhv );
+            size = (unsigned int)bvh_data->size();
+            m_bvh_buffer = btAlignedAlloc(size, 16);
+            memcpy(m_bvh_buffer, bvh_data->data(), size);
+        }
+
+        // 'deSerializeInPlace' makes the btOptimizedBvh object directly at
+        // this memory location, so the buffer is only freed in removeAll.
+        bhv = btOptimizedBvh::deSerializeInPlace(m_bvh_buffer, size,
+                                                 !IS_LITTLE_ENDIAN);
+        if (bhv == NULL)
+        {
+            Log::warn("TriangleMesh", "Failed to load serialized BHV");
+            btAlignedFree(m_bvh_buffer);
+            m_bvh_buffer = NULL;
         }
-        // Do *NOT* free the bytes, 'deSerializeInPlace' makes the btOptimizedBvh object
-        // directly at this memory location
-        //free(bytes);
+    }
 
+    if (bhv == NULL)
+    {
+        bhv_triangle_mesh = new btBvhTriangleMeshShape(&m_mesh, false /* useQuantizedAabbCompression */);
     }
     else
     {
-        bhv_triangle_mesh = new btBvhTriangleMeshShape(&m_mesh, false /* useQuantizedAabbCompression */);
-
-        /*
-         // code to serialize triangle mesh
-        btOptimizedBvh* bvh = bhv_triangle_mesh->getOptimizedBvh();
-        unsigned int ssize = bvh->calculateSerializeBufferSize();
-        char* buffer = (char*)btAlignedAlloc(ssize, 16);
-        bool success = bvh->serialize(buffer, ssize, !IS_LITTLE_ENDIAN);
-        printf("serialization success = %i\n", success);
-
-        std::ofstream fileout("/tmp/btOptimizedBvh");
-        fileout.write(buffer, ssize);
-        fileout.close();
-
-        btAlignedFree(buffer);
-         */
+        bhv_triangle_mesh = new btBvhTriangleMeshShape(&m_mesh, false /* useQuantizedAabbCompression */,
+                                                       false /* buildBvh */);
+        bhv_triangle_mesh->setOptimizedBvh( bhv );
     }
 
     m_collision_shape = bhv_triangle_mesh;
@@ -179,14 +183,19 @@ void TriangleMesh::createCollisionShape(bool create_collision_object, const char
  *  \param flags Additional collision flags (default 0).
  *  \param serializedBhv if non-NULL, the bhv is deserialized instead of
  *                       being calculated on the fly
+ *  \param bvh_data If non-NULL, a bvh serialized by serializeBvh for
+ *                  exactly the same triangles, which is used instead of
+ *                  calculating the bvh.
  */
 void TriangleMesh::createPhysicalBody(float friction,
                                       btCollisionObject::CollisionFlags flags,
-                                      const char* serializedBhv)
+                                      const char* serializedBhv,
+                                      const std::string *bvh_data)
 {
     // We need the collision shape, but not the collision object (since
     // this will be created when the dynamics body is anyway).
-    createCollisionShape(/*create_collision_object*/false, serializedBhv);
+    createCollisionShape(/*create_collision_object*/false, serializedBhv,
+                         bvh_data);
 
     btTransform startTransform;
     startTransform.setIdentity();
@@ -230,8 +239,59 @@ void TriangleMesh::removeAll()
     }
     delete m_collision_shape;
     m_collision_shape = NULL;
+    if(m_bvh_buffer)
+    {
+        btAlignedFree(m_bvh_buffer);
+        m_bvh_buffer = NULL;
+    }
 }   // removeAll
 
+// -----------------------------------------------------------------------------
+/** Serializes the bvh of the collision shape, so that it can be passed to
+ *  createPhysicalBody later to avoid recomputing it. The data is only valid
+ *  in this process (and for a mesh with identical triangles).
+ *  \param out On return the serialized bvh.
+ *  \return False if there is no bvh to serialize.
+ */
+bool TriangleMesh::serializeBvh(std::string *out) const
+{
+    if (!m_collision_shape ||
+        m_collision_shape->getShapeType() != TRIANGLE_MESH_SHAPE_PROXYTYPE)
+        return false;
+    const btOptimizedBvh *bvh =
+        static_cast<btBvhTriangleMeshShape*>(m_collision_shape)
+        ->getOptimizedBvh();
+    if (!bvh)
+        return false;
+
+    unsigned int size = bvh->calculateSerializeBufferSize();
+    void *buffer = btAlignedAlloc(size, 16);
+    bool success = bvh->serializeInPlace(buffer, size, !IS_LITTLE_ENDIAN);
+    if (success)
+        out->assign((const char*)buffer, size);
+    btAlignedFree(buffer);
+    return success;
+}   // serializeBvh
+
+// -----------------------------------------------------------------------------
+/** Returns a hash (FNV-1a) of all vertex positions, used to check that a
+ *  serialized bvh was computed for the same triangles.
+ */
+uint64_t TriangleMesh::getVertexHash() const
+{
+    uint64_t hash = FileUtils::hashBytes(NULL, 0);
+    const IndexedMeshArray &m = m_mesh.getIndexedMeshArray();
+    if (m.size() == 0)
+        return hash;
+    const unsigned char *base = m[0].m_vertexBase;
+    for (int i = 0; i < m[0].m_numVertices; i++)
+    {
+        hash = FileUtils::hashBytes(base + i * m[0].m_vertexStride,
+                                    3 * sizeof(float), hash);
+    }
+    return hash;
+}   // getVertexHash
+
 // -----------------------------------------------------------------------------
 /** Interpolates the normal at the given position for the triangle with
  *  a given index. The position must be inside of the given triangle.
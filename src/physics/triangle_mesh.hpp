@@ -19,6 +19,8 @@
 #ifndef HEADER_TRIANGLE_MESH_HPP
 #define HEADER_TRIANGLE_MESH_HPP
 
+#include <cstdint>
+#include <string>
 #include <vector>
 #include "btBulletDynamicsCommon.h"
 
@@ -46,6 +48,10 @@ private:
     btDefaultMotionState        *m_motion_state;
     btCollisionShape            *m_collision_shape;
 
+    /** If the bvh of the collision shape was deserialized, this is the
+     *  buffer it lives in. It is freed in removeAll. */
+    void                        *m_bvh_buffer;
+
     /** The three normals for each triangle. */
     AlignedArray<btVector3>      m_normals;
 
@@ -76,11 +82,15 @@ public:
                      const btVector3 &t3, const btVector3 &n1,
                      const btVector3 &n2, const btVector3 &n3,
                      const Material* m);
-    void createCollisionShape(bool create_collision_object=true, const char* serialized_bhv=NULL);
+    void createCollisionShape(bool create_collision_object=true, const char* serialized_bhv=NULL,
+                              const std::string *bvh_data=NULL);
     void createPhysicalBody(float friction,
                             btCollisionObject::CollisionFlags flags=
                                (btCollisionObject::CollisionFlags)0,
-                            const char* serializedBhv = NULL);
+                            const char* serializedBhv = NULL,
+                            const std::string *bvh_data = NULL);
+    bool serializeBvh(std::string *out) const;
+    uint64_t getVertexHash() const;
     void removeAll();
     void removeCollisionObject();
     btVector3 getInterpolatedNormal(unsigned int index,
@@ -101,6 +111,10 @@ public:
     }
     const btRigidBody *getBody() const { return m_body; }
     // ------------------------------------------------------------------------
+    /** Returns the number of triangles in this mesh. */
+    unsigned int getNumTriangles() const
+                 { return (unsigned int)m_triangleIndex2Material.size(); }
+    // ------------------------------------------------------------------------
     const Material* getMaterial(int n) const
                                           {return m_triangleIndex2Material[n];}
     // ------------------------------------------------------------------------
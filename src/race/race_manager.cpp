@@ -39,6 +39,7 @@
 #include "scriptengine/property_animator.hpp"
 #include "tracks/track_manager.hpp"
 #include "utils/ptr_vector.hpp"
+#include "utils/snapshot.hpp"
 #include "utils/string_utils.hpp"
 
 RaceManager* race_manager= NULL;
@@ -60,6 +61,7 @@ RaceManager::RaceManager()
     setMaxGoal(0);
     setTimeTarget(0.0f);
     setReverseTrack(false);
+    setRandomSeed(0);
     setRecordRace(false);
     setTrack("jungle");
     m_default_ai_list.clear();
@@ -85,6 +87,38 @@ void RaceManager::reset()
     m_num_finished_players = 0;
 }  // reset
 
+//-----------------------------------------------------------------------------
+/** Saves the number of finished karts and the results of all karts of the
+ *  current race into a snapshot (see World::saveState).
+ */
+void RaceManager::saveState(Snapshot *s) const
+{
+    s->add(m_num_finished_karts);
+    s->add(m_num_finished_players);
+    for (const KartStatus &ks : m_kart_status)
+    {
+        s->add(ks.m_score);
+        s->add(ks.m_last_score);
+        s->add(ks.m_overall_time);
+        s->add(ks.m_last_time);
+    }
+}   // saveState
+
+//-----------------------------------------------------------------------------
+/** Restores the race results saved with saveState. */
+void RaceManager::restoreState(Snapshot *s)
+{
+    s->get(&m_num_finished_karts);
+    s->get(&m_num_finished_players);
+    for (KartStatus &ks : m_kart_status)
+    {
+        s->get(&ks.m_score);
+        s->get(&ks.m_last_score);
+        s->get(&ks.m_overall_time);
+        s->get(&ks.m_last_time);
+    }
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Sets the default list of AI karts to use.
  *  \param ai_kart_list List of the identifier of the karts to use.
@@ -26,6 +26,7 @@
   * track was selected, etc.
   */
 
+#include <cstdint>
 #include <vector>
 #include <algorithm>
 #include <string>
@@ -35,6 +36,7 @@
 
 class AbstractKart;
 class SavedGrandPrix;
+class Snapshot;
 class Track;
 
 static const std::string IDENT_STD      ("STANDARD"        );
@@ -279,6 +281,10 @@ private:
     /** Whether a track should be reversed */
     bool                             m_reverse_track;
 
+    /** Seed all random streams of a world are derived from, see
+     *  RandomGenerator::deriveSeed. */
+    uint32_t                         m_random_seed;
+
     /** The list of default AI karts to use. This is from the command line. */
     std::vector<std::string>         m_default_ai_list;
 
@@ -313,6 +319,8 @@ public:
         ~RaceManager();
 
     void reset();
+    void saveState(Snapshot *s) const;
+    void restoreState(Snapshot *s);
     void setPlayerKart(unsigned int player_id, const std::string &kart_name);
     void setPlayerKart(unsigned int player_id,
                        const RemoteKartInfo& ki);
@@ -374,6 +382,10 @@ public:
         m_reverse_track = r_t;
     }   // setReverseTrack
     // ------------------------------------------------------------------------
+    void setRandomSeed(uint32_t seed) { m_random_seed = seed; }
+    // ------------------------------------------------------------------------
+    uint32_t getRandomSeed() const { return m_random_seed; }
+    // ------------------------------------------------------------------------
     void setMinorMode(MinorRaceModeType mode)
     {
         m_minor_mode = mode;
@@ -57,10 +57,22 @@ namespace Scripting
         Log::warn("Scripting", "%s (%d, %d) : %s : %s\n", msg->section, msg->row, msg->col, type, msg->message);
     }
 
+    asIScriptContext* AngelScript_RequestContext(asIScriptEngine *engine, void *param)
+    {
+        return static_cast<ScriptEngine*>(param)->requestContext();
+    }
+
+    void AngelScript_ReturnContext(asIScriptEngine *engine, asIScriptContext *ctx, void *param)
+    {
+        static_cast<ScriptEngine*>(param)->returnContext(ctx);
+    }
+
 
     //Constructor, creates a new Scripting Engine using AngelScript
     ScriptEngine::ScriptEngine()
     {
+        m_kart_kart_collision_function = NULL;
+
         // Create the script engine
         m_engine = asCreateScriptEngine(ANGELSCRIPT_VERSION);
         if (m_engine == NULL)
@@ -71,6 +83,11 @@ namespace Scripting
         // The script compiler will write any compiler messages to the callback.
         m_engine->SetMessageCallback(asFUNCTION(AngelScript_ErrorCallback), 0, asCALL_CDECL);
 
+        // Let the engine (and add-ons like the script array) reuse contexts
+        // instead of creating a new one for each call.
+        m_engine->SetContextCallbacks(AngelScript_RequestContext,
+                                      AngelScript_ReturnContext, this);
+
         // Configure the script engine with all the functions, 
         // and variables that the script should be able to use.
         configureEngine(m_engine);
@@ -80,10 +97,41 @@ namespace Scripting
     {
         // Release the engine
         m_pending_timeouts.clearAndDeleteAll();
+        for (asIScriptContext *ctx : m_context_pool)
+            ctx->Release();
+        m_context_pool.clear();
         m_engine->DiscardModule(MODULE_ID_MAIN_SCRIPT_FILE);
         m_engine->Release();
     }
 
+    //-----------------------------------------------------------------------------
+    /** Returns a context to execute a script function in. Contexts are
+     *  expensive to create, so finished contexts are kept in a pool. A new
+     *  context is only created if all pooled ones are in use, e.g. when a
+     *  script calls back into the engine which runs another script.
+     */
+    asIScriptContext* ScriptEngine::requestContext()
+    {
+        if (!m_context_pool.empty())
+        {
+            asIScriptContext *ctx = m_context_pool.back();
+            m_context_pool.pop_back();
+            return ctx;
+        }
+        return m_engine->CreateContext();
+    }
+
+    //-----------------------------------------------------------------------------
+    /** Puts a context that was obtained with requestContext back into the
+     *  pool. */
+    void ScriptEngine::returnContext(asIScriptContext *ctx)
+    {
+        if (ctx == NULL)
+            return;
+        ctx->Unprepare();
+        m_context_pool.push_back(ctx);
+    }
+
 
 
     /** Get Script By it's file name
@@ -135,11 +183,12 @@ namespace Scripting
             return;
         }
 
-        asIScriptContext *ctx = m_engine->CreateContext();
+        asIScriptContext *ctx = requestContext();
         if (ctx == NULL)
         {
             Log::error("Scripting", "evalScript: Failed to create the context.");
             //m_engine->Release();
+            func->Release();
             return;
         }
 
@@ -147,7 +196,8 @@ namespace Scripting
         if (r < 0)
         {
             Log::error("Scripting", "evalScript: Failed to prepare the context.");
-            ctx->Release();
+            returnContext(ctx);
+            func->Release();
             return;
         }
 
@@ -170,7 +220,7 @@ namespace Scripting
             }
         }
 
-        ctx->Release();
+        returnContext(ctx);
         func->Release();
     }
 
@@ -178,7 +228,7 @@ namespace Scripting
 
     void ScriptEngine::runDelegate(asIScriptFunction* delegate)
     {
-        asIScriptContext *ctx = m_engine->CreateContext();
+        asIScriptContext *ctx = requestContext();
         if (ctx == NULL)
         {
             Log::error("Scripting", "runMethod: Failed to create the context.");
@@ -190,7 +240,7 @@ namespace Scripting
         if (r < 0)
         {
             Log::error("Scripting", "runMethod: Failed to prepare the context.");
-            ctx->Release();
+            returnContext(ctx);
             return;
         }
 
@@ -215,7 +265,7 @@ namespace Scripting
             }
         }
 
-        ctx->Release();
+        returnContext(ctx);
     }
 
     //-----------------------------------------------------------------------------
@@ -272,7 +322,7 @@ namespace Scripting
     /** runs the specified script
     *  \param string scriptName = name of script to run
     */
-    void ScriptEngine::runFunction(bool warn_if_not_found, std::string function_name)
+    void ScriptEngine::runFunction(bool warn_if_not_found, const std::string &function_name)
     {
         std::function<void(asIScriptContext*)> callback;
         std::function<void(asIScriptContext*)> get_return_value;
@@ -281,8 +331,8 @@ namespace Scripting
 
     //-----------------------------------------------------------------------------
 
-    void ScriptEngine::runFunction(bool warn_if_not_found, std::string function_name,
-        std::function<void(asIScriptContext*)> callback)
+    void ScriptEngine::runFunction(bool warn_if_not_found, const std::string &function_name,
+        const std::function<void(asIScriptContext*)> &callback)
     {
         std::function<void(asIScriptContext*)> get_return_value;
         runFunction(warn_if_not_found, function_name, callback, get_return_value);
@@ -293,16 +343,31 @@ namespace Scripting
     /** runs the specified script
     *  \param string scriptName = name of script to run
     */
-    void ScriptEngine::runFunction(bool warn_if_not_found, std::string function_name,
-        std::function<void(asIScriptContext*)> callback,
-        std::function<void(asIScriptContext*)> get_return_value)
+    void ScriptEngine::runFunction(bool warn_if_not_found, const std::string &function_name,
+        const std::function<void(asIScriptContext*)> &callback,
+        const std::function<void(asIScriptContext*)> &get_return_value)
     {
-        int r; //int for error checking
+        asIScriptFunction *func = getFunction(warn_if_not_found, function_name);
+        if (func == NULL)
+            return; // function unavailable
+
+        executeFunction(func, callback, get_return_value);
+    }
 
+    //-----------------------------------------------------------------------------
+    /** Looks up a function of the main script by its declaration. The result
+     *  (also if the function does not exist) is cached until cleanupCache is
+     *  called, so callers may keep the returned function until then.
+     *  \param function_name The declaration of the function, e.g.
+     *         "void onStart()".
+     *  \return The function, or NULL if the script does not define it.
+     */
+    asIScriptFunction* ScriptEngine::getFunction(bool warn_if_not_found,
+                                                 const std::string &function_name)
+    {
         asIScriptFunction *func;
 
         // TODO: allow splitting in multiple files
-        std::string script_filename = "scripting.as";
         auto cached_function = m_functions_cache.find(function_name);
         if (cached_function == m_functions_cache.end())
         {
@@ -318,7 +383,7 @@ namespace Scripting
                 else
                     Log::debug("Scripting", "Scripting function was not found : %s (module not found)", function_name.c_str());
                 m_functions_cache[function_name] = NULL; // remember that this function is unavailable
-                return;
+                return NULL;
             }
 
             func = module->GetFunctionByDecl(function_name.c_str());
@@ -330,7 +395,7 @@ namespace Scripting
                 else
                     Log::debug("Scripting", "Scripting function was not found : %s", function_name.c_str());
                 m_functions_cache[function_name] = NULL; // remember that this function is unavailable
-                return;
+                return NULL;
             }
 
             m_functions_cache[function_name] = func;
@@ -340,17 +405,25 @@ namespace Scripting
         {
             // Script present in cache
             func = cached_function->second;
-        }
-
-        if (func == NULL)
-        {
-            if (warn_if_not_found)
+            if (func == NULL && warn_if_not_found)
                 Log::warn("Scripting", "Scripting function was not found : %s", function_name.c_str());
-            return; // function unavailable
         }
 
-        // Create a context that will execute the script.
-        asIScriptContext *ctx = m_engine->CreateContext();
+        return func;
+    }   // getFunction
+
+    //-----------------------------------------------------------------------------
+    /** Executes a function obtained from getFunction.
+     *  \param callback Called before the execution to set the arguments.
+     *  \param get_return_value Called after a successful execution to read
+     *         the return value.
+     */
+    void ScriptEngine::executeFunction(asIScriptFunction *func,
+        const std::function<void(asIScriptContext*)> &callback,
+        const std::function<void(asIScriptContext*)> &get_return_value)
+    {
+        // Get a context that will execute the script.
+        asIScriptContext *ctx = requestContext();
         if (ctx == NULL)
         {
             Log::error("Scripting", "Failed to create the context.");
@@ -363,11 +436,11 @@ namespace Scripting
         // executed. Note, that if because we intend to execute the same function 
         // several times, we will store the function returned by 
         // GetFunctionByDecl(), so that this relatively slow call can be skipped.
-        r = ctx->Prepare(func);
+        int r = ctx->Prepare(func);
         if (r < 0)
         {
             Log::error("Scripting", "Failed to prepare the context.");
-            ctx->Release();
+            returnContext(ctx);
             //m_engine->Release();
             return;
         }
@@ -415,9 +488,9 @@ namespace Scripting
                 get_return_value(ctx);
         }
 
-        // We must release the contexts when no longer using them
-        ctx->Release();
-    }
+        // Hand the context back to the pool when no longer using it
+        returnContext(ctx);
+    }   // executeFunction
 
     //-----------------------------------------------------------------------------
 
@@ -429,6 +502,7 @@ namespace Scripting
                 curr.second->Release();
         }
         m_functions_cache.clear();
+        m_kart_kart_collision_function = NULL;
         m_engine->DiscardModule(MODULE_ID_MAIN_SCRIPT_FILE);
     }
 
@@ -509,6 +583,11 @@ namespace Scripting
             return false;
         }
 
+        // Resolve the callbacks that are run for every collision once, so
+        // that tracks without such a callback don't pay for the lookup.
+        m_kart_kart_collision_function =
+            getFunction(false, "void onKartKartCollision(int, int)");
+
         // The engine doesn't keep a copy of the script sections after Build() has
         // returned. So if the script needs to be recompiled, then all the script
         // sections must be added again.
@@ -28,6 +28,7 @@
 #include <functional>
 #include <map>
 #include <string>
+#include <vector>
 
 class TrackObjectPresentation;
 
@@ -67,12 +68,18 @@ namespace Scripting
     public:
 
 
-        void runFunction(bool warn_if_not_found, std::string function_name);
-        void runFunction(bool warn_if_not_found, std::string function_name,
-            std::function<void(asIScriptContext*)> callback);
-        void runFunction(bool warn_if_not_found, std::string function_name,
-            std::function<void(asIScriptContext*)> callback,
-            std::function<void(asIScriptContext*)> get_return_value);
+        void runFunction(bool warn_if_not_found, const std::string &function_name);
+        void runFunction(bool warn_if_not_found, const std::string &function_name,
+            const std::function<void(asIScriptContext*)> &callback);
+        void runFunction(bool warn_if_not_found, const std::string &function_name,
+            const std::function<void(asIScriptContext*)> &callback,
+            const std::function<void(asIScriptContext*)> &get_return_value);
+        void executeFunction(asIScriptFunction *func,
+            const std::function<void(asIScriptContext*)> &callback,
+            const std::function<void(asIScriptContext*)> &get_return_value =
+                std::function<void(asIScriptContext*)>());
+        asIScriptFunction* getFunction(bool warn_if_not_found,
+                                       const std::string &function_name);
         void runDelegate(asIScriptFunction* delegate_fn);
         void evalScript(std::string script_fragment);
         void cleanupCache();
@@ -84,13 +91,31 @@ namespace Scripting
         void addPendingTimeout(double time, asIScriptFunction* delegate_fn);
         void update(float dt);
 
+        asIScriptContext* requestContext();
+        void returnContext(asIScriptContext *ctx);
+
         asIScriptEngine* getEngine() { return m_engine; }
 
+        /** Returns the onKartKartCollision callback of the track script, or
+         *  NULL if the track does not define one. */
+        asIScriptFunction* getKartKartCollisionFunction() const
+        {
+            return m_kart_kart_collision_function;
+        }
+
     private:
         asIScriptEngine *m_engine;
         std::map<std::string, asIScriptFunction*> m_functions_cache;
         PtrVector<PendingTimeout> m_pending_timeouts;
 
+        /** Contexts that finished executing and can be reused, see
+         *  requestContext. */
+        std::vector<asIScriptContext*> m_context_pool;
+
+        /** Callbacks that are invoked very frequently are resolved once
+         *  after the scripts are compiled. */
+        asIScriptFunction *m_kart_kart_collision_function;
+
         void configureEngine(asIScriptEngine *engine);
     };   // class ScriptEngine
 
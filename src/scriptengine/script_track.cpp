@@ -19,6 +19,7 @@
 #include "script_track.hpp"
 
 #include "animations/three_d_animation.hpp"
+#include "config/user_config.hpp"
 #include "font/digit_face.hpp"
 #include "font/font_manager.hpp"
 #include "graphics/central_settings.hpp"
@@ -104,6 +105,9 @@ namespace Scripting
 
         void createTextBillboard(std::string* text, SimpleVec3* location)
         {
+            // No fonts are loaded in physics only mode
+            if (UserConfigParams::m_physics_only)
+                return;
             core::stringw wtext = StringUtils::utf8ToWide(*text);
             DigitFace* digit_face = font_manager->getFont<DigitFace>();
             core::vector3df xyz(location->getX(), location->getY(), location->getZ());
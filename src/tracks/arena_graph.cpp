@@ -24,20 +24,51 @@
 #include "tracks/arena_node.hpp"
 #include "tracks/track.hpp"
 #include "tracks/track_manager.hpp"
+#include "utils/file_utils.hpp"
 #include "utils/log.hpp"
+#include "utils/string_utils.hpp"
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <queue>
 
+namespace
+{
+    /** Identifies the file format of the distance cache, change it if the
+     *  format or the shortest path computation changes. */
+    const char DISTANCE_CACHE_MAGIC[8] = "STKNAV1";
+
+    /** Header of the distance cache file, followed by the distance and the
+     *  parent matrix. */
+    struct DistanceCacheHeader
+    {
+        char     m_magic[8];
+        uint32_t m_num_nodes;
+        uint32_t m_unused;
+        uint64_t m_navmesh_hash;
+    };   // DistanceCacheHeader
+}   // namespace
+
 // -----------------------------------------------------------------------------
 ArenaGraph::ArenaGraph(const std::string &navmesh, const XMLNode *node)
           : Graph()
 {
     loadNavmesh(navmesh);
-    buildGraph();
-    // Compute shortest distance from all nodes
-    for (unsigned int i = 0; i < getNumNodes(); i++)
-        computeDijkstra(i);
+    buildGrid();
+
+    // The shortest paths only depend on the navmesh, so they are computed
+    // once and then loaded from the cache file.
+    const std::string cache_file = getDistanceCacheFile(navmesh);
+    const uint64_t navmesh_hash = FileUtils::hashFile(navmesh);
+    if (!loadDistanceCache(cache_file, navmesh_hash))
+    {
+        buildGraph();
+        // Compute shortest distance from all nodes
+        for (unsigned int i = 0; i < getNumNodes(); i++)
+            computeDijkstra(i);
+        saveDistanceCache(cache_file, navmesh_hash);
+    }
 
     setNearbyNodesOfAllNodes();
     if (node && race_manager->getMinorMode() == RaceManager::MINOR_MODE_SOCCER)
@@ -170,8 +201,7 @@ void ArenaGraph::buildGraph()
 {
     const unsigned int n_nodes = getNumNodes();
 
-    m_distance_matrix = std::vector<std::vector<float>>
-        (n_nodes, std::vector<float>(n_nodes, 9999.9f));
+    m_distance_matrix = std::vector<float>(n_nodes * n_nodes, 9999.9f);
     for (unsigned int i = 0; i < n_nodes; i++)
     {
         ArenaNode* cur_node = getNode(i);
@@ -179,27 +209,118 @@ void ArenaGraph::buildGraph()
         {
             Vec3 diff = getNode(adjacent)->getCenter() - cur_node->getCenter();
             float distance = diff.length();
-            m_distance_matrix[i][adjacent] = distance;
+            m_distance_matrix[i * n_nodes + adjacent] = distance;
         }
-        m_distance_matrix[i][i] = 0.0f;
+        m_distance_matrix[i * n_nodes + i] = 0.0f;
     }
 
     // Allocate and initialise the previous node data structure:
-    m_parent_node = std::vector<std::vector<int16_t>>
-        (n_nodes, std::vector<int16_t>(n_nodes, Graph::UNKNOWN_SECTOR));
+    m_parent_node = std::vector<int16_t>(n_nodes * n_nodes,
+                                         Graph::UNKNOWN_SECTOR);
     for (unsigned int i = 0; i < n_nodes; i++)
     {
         for (unsigned int j = 0; j < n_nodes; j++)
         {
-            if (i == j || m_distance_matrix[i][j] >= 9899.9f)
-                m_parent_node[i][j] = -1;
+            if (i == j || m_distance_matrix[i * n_nodes + j] >= 9899.9f)
+                m_parent_node[i * n_nodes + j] = -1;
             else
-                m_parent_node[i][j] = i;
+                m_parent_node[i * n_nodes + j] = i;
         }   // for j
     }   // for i
 
 }   // buildGraph
 
+// ----------------------------------------------------------------------------
+/** Returns the name of the file in which the shortest paths of this navmesh
+ *  are cached. It is stored in its own subdirectory of the user's cache
+ *  directory, since the track directory might not be writable.
+ *  \param navmesh Full path of the navmesh file.
+ */
+std::string ArenaGraph::getDistanceCacheFile(const std::string &navmesh) const
+{
+    std::string track_dir = StringUtils::getBasename(
+        StringUtils::getPath(navmesh));
+    return file_manager->getCachedTexturesDir() + "arena/" + track_dir +
+           ".bin";
+}   // getDistanceCacheFile
+
+// ----------------------------------------------------------------------------
+/** Loads the distance and parent matrix from the cache file. The file is
+ *  only used if it was written for a navmesh with the same hash and the same
+ *  number of nodes.
+ *  \param file The cache file.
+ *  \param navmesh_hash Hash of the content of the navmesh file.
+ *  \return True if the matrices were loaded.
+ */
+bool ArenaGraph::loadDistanceCache(const std::string &file,
+                                   uint64_t navmesh_hash)
+{
+    const unsigned int n = getNumNodes();
+    if (navmesh_hash == 0 || n == 0)
+        return false;
+    FILE *f = fopen(file.c_str(), "rb");
+    if (!f)
+        return false;
+
+    DistanceCacheHeader header;
+    bool valid = fread(&header, sizeof(header), 1, f) == 1 &&
+        memcmp(header.m_magic, DISTANCE_CACHE_MAGIC,
+               sizeof(header.m_magic)) == 0 &&
+        header.m_num_nodes == n && header.m_navmesh_hash == navmesh_hash;
+    if (valid)
+    {
+        m_distance_matrix.resize(n * n);
+        m_parent_node.resize(n * n);
+        valid = fread(m_distance_matrix.data(), sizeof(float), n * n, f)
+                == n * n &&
+                fread(m_parent_node.data(), sizeof(int16_t), n * n, f)
+                == n * n;
+    }
+    fclose(f);
+    if (!valid)
+    {
+        Log::info("ArenaGraph", "Distance cache '%s' is outdated.",
+                  file.c_str());
+        m_distance_matrix.clear();
+        m_parent_node.clear();
+    }
+    return valid;
+}   // loadDistanceCache
+
+// ----------------------------------------------------------------------------
+/** Saves the distance and parent matrix to the cache file, see
+ *  FileUtils::writeFileAtomic.
+ *  \param file The cache file.
+ *  \param navmesh_hash Hash of the content of the navmesh file.
+ */
+void ArenaGraph::saveDistanceCache(const std::string &file,
+                                   uint64_t navmesh_hash) const
+{
+    const unsigned int n = getNumNodes();
+    if (navmesh_hash == 0 || n == 0)
+        return;
+    if (!file_manager->checkAndCreateDirectoryP(StringUtils::getPath(file)))
+        return;
+
+    DistanceCacheHeader header;
+    memcpy(header.m_magic, DISTANCE_CACHE_MAGIC, sizeof(header.m_magic));
+    header.m_num_nodes    = n;
+    header.m_unused       = 0;
+    header.m_navmesh_hash = navmesh_hash;
+    bool success = FileUtils::writeFileAtomic(file, [&](FILE *f)
+    {
+        return fwrite(&header, sizeof(header), 1, f) == 1 &&
+            fwrite(m_distance_matrix.data(), sizeof(float), n * n, f) ==
+                n * n &&
+            fwrite(m_parent_node.data(), sizeof(int16_t), n * n, f) == n * n;
+    });
+    if (!success)
+    {
+        Log::warn("ArenaGraph", "Can't write distance cache '%s'.",
+                  file.c_str());
+    }
+}   // saveDistanceCache
+
 // ----------------------------------------------------------------------------
 /** Dijkstra shortest path computation. It computes the shortest distance from
  *  the specified node 'source' to all other nodes. At the end of the
@@ -243,11 +364,11 @@ void ArenaGraph::computeDijkstra(int source)
             if (visited[adjacent]) continue;
 
             float new_dist =
-                current.second + m_distance_matrix[cur_index][adjacent];
-            if (new_dist < m_distance_matrix[source][adjacent])
+                current.second + m_distance_matrix[cur_index * n + adjacent];
+            if (new_dist < m_distance_matrix[source * n + adjacent])
             {
-                m_distance_matrix[source][adjacent] = new_dist;
-                m_parent_node[source][adjacent] = cur_index;
+                m_distance_matrix[source * n + adjacent] = new_dist;
+                m_parent_node[source * n + adjacent] = cur_index;
             }
             IndDistPair pair(adjacent, new_dist);
             queue.push(pair);
@@ -275,12 +396,14 @@ void ArenaGraph::computeFloydWarshall()
         {
             for (unsigned int j = 0; j < n; j++)
             {
-                if ((m_distance_matrix[i][k] + m_distance_matrix[k][j]) <
-                    m_distance_matrix[i][j])
+                if ((m_distance_matrix[i * n + k] +
+                     m_distance_matrix[k * n + j]) <
+                    m_distance_matrix[i * n + j])
                 {
-                    m_distance_matrix[i][j] =
-                        m_distance_matrix[i][k] + m_distance_matrix[k][j];
-                    m_parent_node[i][j] = m_parent_node[k][j];
+                    m_distance_matrix[i * n + j] =
+                        m_distance_matrix[i * n + k] +
+                        m_distance_matrix[k * n + j];
+                    m_parent_node[i * n + j] = m_parent_node[k * n + j];
                 }
             }
         }
@@ -332,7 +455,9 @@ void ArenaGraph::setNearbyNodesOfAllNodes()
         // Get the distance to all nodes at i
         ArenaNode* cur_node = getNode(i);
         std::vector<int> nearby_nodes;
-        std::vector<float> dist = m_distance_matrix[i];
+        std::vector<float> dist(m_distance_matrix.begin() + i * getNumNodes(),
+                                m_distance_matrix.begin() +
+                                (i + 1) * getNumNodes());
 
         // Skip the same node
         dist[i] = 999999.0f;
@@ -354,13 +479,14 @@ void ArenaGraph::setNearbyNodesOfAllNodes()
  *  std::vector (in reverse order). Used only for unit testing.
  */
 std::vector<int16_t> ArenaGraph::getPathFromTo(int from, int to,
-                      const std::vector< std::vector< int16_t > >& parent_node)
+                                const std::vector<int16_t>& parent_node,
+                                unsigned int n)
 {
     std::vector<int16_t> path;
     path.push_back(to);
     while(from!=to)
     {
-        to = parent_node[from][to];
+        to = parent_node[from * n + to];
         path.push_back(to);
     }
     return path;
@@ -22,7 +22,10 @@
 #include "tracks/graph.hpp"
 #include "utils/cpp2011.hpp"
 
+#include <cstdint>
 #include <set>
+#include <string>
+#include <vector>
 
 class ArenaNode;
 class XMLNode;
@@ -34,11 +37,14 @@ class XMLNode;
 class ArenaGraph : public Graph
 {
 private:
-    /** The actual graph data structure, it is an adjacency matrix. */
-    std::vector<std::vector<float>> m_distance_matrix;
+    /** The shortest path distance between all pairs of nodes, stored row
+     *  major: the distance from i to j is m_distance_matrix[i*n+j]. Before
+     *  the shortest paths are computed it is the adjacency matrix. */
+    std::vector<float> m_distance_matrix;
 
-    /** The matrix that is used to store computed shortest paths. */
-    std::vector<std::vector<int16_t>> m_parent_node;
+    /** The matrix that is used to store computed shortest paths, stored
+     *  row major like m_distance_matrix. */
+    std::vector<int16_t> m_parent_node;
 
     /** Used in soccer mode to colorize the goal lines in minimap. */
     std::set<int> m_red_node;
@@ -52,6 +58,13 @@ private:
     // ------------------------------------------------------------------------
     void buildGraph();
     // ------------------------------------------------------------------------
+    std::string getDistanceCacheFile(const std::string &navmesh) const;
+    // ------------------------------------------------------------------------
+    bool loadDistanceCache(const std::string &file, uint64_t navmesh_hash);
+    // ------------------------------------------------------------------------
+    void saveDistanceCache(const std::string &file,
+                           uint64_t navmesh_hash) const;
+    // ------------------------------------------------------------------------
     void setNearbyNodesOfAllNodes();
     // ------------------------------------------------------------------------
     void computeDijkstra(int n);
@@ -59,7 +72,8 @@ private:
     void computeFloydWarshall();
     // ------------------------------------------------------------------------
     static std::vector<int16_t> getPathFromTo(int from, int to,
-                     const std::vector< std::vector< int16_t > >& parent_node);
+                                const std::vector<int16_t>& parent_node,
+                                unsigned int n);
     // ------------------------------------------------------------------------
     virtual bool hasLapLine() const OVERRIDE                  { return false; }
     // ------------------------------------------------------------------------
@@ -82,7 +96,7 @@ public:
     {
         if (i == Graph::UNKNOWN_SECTOR || j == Graph::UNKNOWN_SECTOR)
             return Graph::UNKNOWN_SECTOR;
-        return (int)(m_parent_node[j][i]);
+        return (int)(m_parent_node[j * getNumNodes() + i]);
     }
     // ------------------------------------------------------------------------
     /** Returns the distance between any two nodes */
@@ -90,7 +104,7 @@ public:
     {
         if (from == Graph::UNKNOWN_SECTOR || to == Graph::UNKNOWN_SECTOR)
             return 99999.0f;
-        return m_distance_matrix[from][to];
+        return m_distance_matrix[from * getNumNodes() + to];
     }
 
 };   // ArenaGraph
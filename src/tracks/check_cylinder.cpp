@@ -25,6 +25,7 @@
 #include "items/item.hpp"
 #include "modes/world.hpp"
 #include "race/race_manager.hpp"
+#include "utils/snapshot.hpp"
 #include "tracks/check_manager.hpp"
 
 CheckCylinder::CheckCylinder(const XMLNode &node,
@@ -80,3 +81,19 @@ bool CheckCylinder::isTriggered(const Vec3 &old_pos, const Vec3 &new_pos,
 
     return triggered;
 }   // isTriggered
+
+// ----------------------------------------------------------------------------
+void CheckCylinder::saveState(Snapshot *s) const
+{
+    CheckStructure::saveState(s);
+    s->add(m_is_inside);
+    s->add(m_distance2);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+void CheckCylinder::restoreState(Snapshot *s)
+{
+    CheckStructure::restoreState(s);
+    s->get(&m_is_inside);
+    s->get(&m_distance2);
+}   // restoreState
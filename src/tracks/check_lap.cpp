@@ -25,6 +25,7 @@
 #include "modes/linear_world.hpp"
 #include "race/race_manager.hpp"
 #include "tracks/track.hpp"
+#include "utils/snapshot.hpp"
 
 /** Constructor for a lap line.
  *  \param check_manager Pointer to the check manager, which is needed when
@@ -49,6 +50,20 @@ void CheckLap::reset(const Track &track)
     }
 }   // reset
 
+// ----------------------------------------------------------------------------
+void CheckLap::saveState(Snapshot *s) const
+{
+    CheckStructure::saveState(s);
+    s->add(m_previous_distance);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+void CheckLap::restoreState(Snapshot *s)
+{
+    CheckStructure::restoreState(s);
+    s->get(&m_previous_distance);
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** True if going from old_pos to new_pos crosses this checkline. This function
  *  is called from update (of the checkline structure).
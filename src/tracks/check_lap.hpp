@@ -43,6 +43,8 @@ public:
     virtual bool isTriggered(const Vec3 &old_pos, const Vec3 &new_pos,
                              int indx) OVERRIDE;
     virtual void reset(const Track &track) OVERRIDE;
+    virtual void saveState(Snapshot *s) const OVERRIDE;
+    virtual void restoreState(Snapshot *s) OVERRIDE;
     virtual bool triggeringCheckline() const OVERRIDE { return true; }
 };   // CheckLine
 
@@ -28,6 +28,7 @@
 #include "modes/world.hpp"
 
 #include "race/race_manager.hpp"
+#include "utils/snapshot.hpp"
 
 #include "irrlicht.h"
 
@@ -96,6 +97,20 @@ void CheckLine::reset(const Track &track)
     }
 }   // reset
 
+// ----------------------------------------------------------------------------
+void CheckLine::saveState(Snapshot *s) const
+{
+    CheckStructure::saveState(s);
+    s->add(m_previous_sign);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+void CheckLine::restoreState(Snapshot *s)
+{
+    CheckStructure::restoreState(s);
+    s->get(&m_previous_sign);
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 void CheckLine::resetAfterKartMove(unsigned int kart_index)
 {
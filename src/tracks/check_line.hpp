@@ -88,6 +88,8 @@ public:
     virtual bool isTriggered(const Vec3 &old_pos, const Vec3 &new_pos,
                              int indx) OVERRIDE;
     virtual void reset(const Track &track) OVERRIDE;
+    virtual void saveState(Snapshot *s) const OVERRIDE;
+    virtual void restoreState(Snapshot *s) OVERRIDE;
     virtual void resetAfterKartMove(unsigned int kart_index) OVERRIDE;
     virtual void changeDebugColor(bool is_active) OVERRIDE;
     virtual bool triggeringCheckline() const OVERRIDE { return true; }
@@ -32,6 +32,7 @@
 #include "tracks/check_structure.hpp"
 #include "tracks/drive_graph.hpp"
 #include "utils/log.hpp"
+#include "utils/snapshot.hpp"
 
 CheckManager *CheckManager::m_check_manager = NULL;
 
@@ -119,6 +120,22 @@ void CheckManager::reset(const Track &track)
         (*i)->reset(track);
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the state of all check structures into a snapshot. */
+void CheckManager::saveState(Snapshot *s) const
+{
+    for (const CheckStructure *cs : m_all_checks)
+        cs->saveState(s);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state of all check structures saved with saveState. */
+void CheckManager::restoreState(Snapshot *s)
+{
+    for (CheckStructure *cs : m_all_checks)
+        cs->restoreState(s);
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Called after a kart is moved (e.g. after a rescue) to reset any cached
  *  check information. Without this an incorrect crossing of a checkline
@@ -28,6 +28,7 @@
 class AbstractKart;
 class CheckStructure;
 class Flyable;
+class Snapshot;
 class Track;
 class XMLNode;
 class Vec3;
@@ -52,6 +53,8 @@ public:
     void   load(const XMLNode &node);
     void   update(float dt);
     void   reset(const Track &track);
+    void   saveState(Snapshot *s) const;
+    void   restoreState(Snapshot *s);
     void   resetAfterKartMove(AbstractKart *kart);
     unsigned int getLapLineIndex() const;
     int    getChecklineTriggering(const Vec3 &from, const Vec3 &to) const;
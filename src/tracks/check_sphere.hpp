@@ -49,6 +49,8 @@ public:
     virtual     ~CheckSphere() {};
     virtual bool isTriggered(const Vec3 &old_pos, const Vec3 &new_pos,
                              int kart_id);
+    virtual void saveState(Snapshot *s) const;
+    virtual void restoreState(Snapshot *s);
     // ------------------------------------------------------------------------
     /** Returns if kart indx is currently inside of the sphere. */
     bool isInside(int index) const            { return m_is_inside[index]; }
@@ -26,6 +26,7 @@
 #include "race/race_manager.hpp"
 #include "tracks/check_lap.hpp"
 #include "tracks/check_manager.hpp"
+#include "utils/snapshot.hpp"
 
 #include <algorithm>
 
@@ -93,6 +94,22 @@ void CheckStructure::reset(const Track &track)
     }   // for i<getNumKarts
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the per kart state of this check structure into a snapshot. */
+void CheckStructure::saveState(Snapshot *s) const
+{
+    s->add(m_previous_position);
+    s->add(m_is_active);
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the per kart state saved with saveState. */
+void CheckStructure::restoreState(Snapshot *s)
+{
+    s->get(&m_previous_position);
+    s->get(&m_is_active);
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** Updates all check structures. Called one per time step.
  *  \param dt Time since last call.
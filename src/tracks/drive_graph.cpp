@@ -156,6 +156,7 @@ void DriveGraph::load(const std::string &quad_file_name,
             max_height_testing);
     }
     delete quad;
+    buildGrid();
 
     const XMLNode *xml = file_manager->createXMLTree(filename);
 
@@ -280,6 +281,16 @@ void DriveGraph::computeChecklineRequirements()
                                  CheckManager::get()->getLapLineIndex());
 }   // computeChecklineRequirements
 
+// ----------------------------------------------------------------------------
+/** Removes the checkline requirements of all nodes, e.g. when the graph is
+ *  reused for a race that does not use them.
+ */
+void DriveGraph::resetChecklineRequirements()
+{
+    for (unsigned int i = 0; i < getNumNodes(); i++)
+        getNode(i)->resetChecklineRequirements();
+}   // resetChecklineRequirements
+
 // ----------------------------------------------------------------------------
 /** Finds which checklines must be visited before driving on this quad
  *  (useful for rescue)
@@ -115,6 +115,10 @@ public:
     // ------------------------------------------------------------------------
     void         setChecklineRequirements(int latest_checkline);
     // ------------------------------------------------------------------------
+    /** Removes all checkline requirements of this node. */
+    void         resetChecklineRequirements()
+                                         { m_checkline_requirements.clear(); }
+    // ------------------------------------------------------------------------
     void         setDirectionData(unsigned int successor, DirectionType dir,
                                   unsigned int last_node_index);
     // ------------------------------------------------------------------------
@@ -32,6 +32,8 @@
 #include "tracks/track.hpp"
 #include "utils/log.hpp"
 
+#include <algorithm>
+
 const int Graph::UNKNOWN_SECTOR = -1;
 const float Graph::MIN_HEIGHT_TESTING = -1.0f;
 const float Graph::MAX_HEIGHT_TESTING = 5.0f;
@@ -46,6 +48,11 @@ Graph::Graph()
     m_bb_min      = Vec3( 99999,  99999,  99999);
     m_bb_max      = Vec3(-99999, -99999, -99999);
     memset(m_bb_nodes, 0, 4 * sizeof(int));
+    m_grid_min_x     = 0;
+    m_grid_min_z     = 0;
+    m_grid_cell_size = 1;
+    m_grid_width     = 0;
+    m_grid_height    = 0;
 }  // Graph
 
 // -----------------------------------------------------------------------------
@@ -492,6 +499,35 @@ void Graph::findRoadSector(const Vec3& xyz, int *sector,
                             ? (unsigned int)all_sectors->size()
                             : (unsigned int)m_all_nodes.size();
     *sector = UNKNOWN_SECTOR;
+
+    // Without a list of sectors only the quads in the grid cell of xyz can
+    // contain xyz. To get the same result as the search below, the first
+    // quad after indx (in the order used below) is picked.
+    if (!all_sectors && !m_grid_start.empty())
+    {
+        if (xyz.getX() < m_grid_min_x || xyz.getZ() < m_grid_min_z ||
+            xyz.getX() >= m_grid_min_x + m_grid_width  * m_grid_cell_size ||
+            xyz.getZ() >= m_grid_min_z + m_grid_height * m_grid_cell_size)
+            return;
+        const int n    = (int)m_all_nodes.size();
+        const int cell = getGridZ(xyz.getZ())*m_grid_width
+                       + getGridX(xyz.getX());
+        int best_order = n;
+        for (unsigned int k = m_grid_start[cell]; k < m_grid_start[cell+1];
+             k++)
+        {
+            const int i     = m_grid_quads[k];
+            const int order = (i - indx - 1 + n) % n;
+            if (order < best_order &&
+                getQuad(i)->pointInside(xyz, ignore_vertical))
+            {
+                *sector    = i;
+                best_order = order;
+            }
+        }
+        return;
+    }   // if grid
+
     for(unsigned int i=0; i<max_count; i++)
     {
         if(all_sectors)
@@ -565,6 +601,9 @@ int Graph::findOutOfRoadSector(const Vec3& xyz, const int curr_sector,
         if(current_sector<0) current_sector += getNumNodes();
     }
 
+    if (!all_sectors && !m_grid_start.empty())
+        return findOutOfRoadSectorInGrid(xyz, current_sector, ignore_vertical);
+
     int   min_sector = UNKNOWN_SECTOR;
     float min_dist_2 = 999999.0f*999999.0f;
 
@@ -620,6 +659,182 @@ int Graph::findOutOfRoadSector(const Vec3& xyz, const int curr_sector,
     return 0;
 }   // findOutOfRoadSector
 
+//-----------------------------------------------------------------------------
+/** Implements findOutOfRoadSector with the grid: the cells are visited in
+ *  rings of increasing distance around xyz, until no quad in the remaining
+ *  rings can be closer than the closest quad found so far. Ties are broken
+ *  by the order in which findOutOfRoadSector tests the quads, so the result
+ *  is the same as testing all quads.
+ *  \param xyz Position for which the sector should be determined.
+ *  \param start The quad tested before the first quad, i.e. the quads are
+ *         ordered start+1, start+2, ...
+ *  \param ignore_vertical True if the height test should not be done.
+ */
+int Graph::findOutOfRoadSectorInGrid(const Vec3 &xyz, int start,
+                                     bool ignore_vertical) const
+{
+    const int n = (int)m_all_nodes.size();
+
+    // Project xyz onto the grid: a point outside of the grid is at least
+    // as far from each quad as its projection, plus the distance to it.
+    const float max_x = m_grid_min_x + m_grid_width  * m_grid_cell_size;
+    const float max_z = m_grid_min_z + m_grid_height * m_grid_cell_size;
+    const float px = std::min(std::max(xyz.getX(), m_grid_min_x), max_x);
+    const float pz = std::min(std::max(xyz.getZ(), m_grid_min_z), max_z);
+    const float outside_2 = (xyz.getX() - px)*(xyz.getX() - px)
+                          + (xyz.getZ() - pz)*(xyz.getZ() - pz);
+    const int cx = getGridX(px);
+    const int cz = getGridZ(pz);
+
+    // Same two phases as in findOutOfRoadSector
+    for (int phase = 0; phase < 2; phase++)
+    {
+        int   min_sector = UNKNOWN_SECTOR;
+        int   min_order  = n;
+        float min_dist_2 = 999999.0f*999999.0f;
+        for (int r = 0; ; r++)
+        {
+            const int x0 = cx - r, x1 = cx + r, z0 = cz - r, z1 = cz + r;
+            for (int z = std::max(z0, 0); z <= std::min(z1, m_grid_height-1);
+                 z++)
+            {
+                // Only the border of the ring, the inside was done already
+                const int step = (z == z0 || z == z1) ? 1 : x1 - x0;
+                for (int x = x0; x <= x1; x += std::max(step, 1))
+                {
+                    if (x < 0 || x >= m_grid_width) continue;
+                    const int cell = z*m_grid_width + x;
+                    for (unsigned int k = m_grid_start[cell];
+                         k < m_grid_start[cell + 1]; k++)
+                    {
+                        const int i = m_grid_quads[k];
+                        const Quad *q = getQuad(i);
+                        if (q->isIgnored()) continue;
+                        const float dist_2 = q->getDistance2FromPoint(xyz);
+                        const int order = ((i - start - 1) % n + n) % n;
+                        if (dist_2 > min_dist_2 ||
+                            (dist_2 == min_dist_2 && order >= min_order))
+                            continue;
+                        const float dist = xyz.getY() - q->getMinHeight();
+                        if (phase == 1 || (dist < 5.0f && dist>-1.0f) ||
+                            q->is3DQuad() || ignore_vertical)
+                        {
+                            min_dist_2 = dist_2;
+                            min_sector = i;
+                            min_order  = order;
+                        }
+                    }   // for k
+                }   // for x
+            }   // for z
+
+            // Minimum distance of any cell outside of this ring, ignoring
+            // the sides of the ring which are already outside of the grid.
+            // The small tolerance protects against rounding errors.
+            float d = 999999.0f;
+            if (x0 > 0)
+                d = std::min(d, px - (m_grid_min_x + x0*m_grid_cell_size));
+            if (x1 < m_grid_width - 1)
+                d = std::min(d, m_grid_min_x + (x1+1)*m_grid_cell_size - px);
+            if (z0 > 0)
+                d = std::min(d, pz - (m_grid_min_z + z0*m_grid_cell_size));
+            if (z1 < m_grid_height - 1)
+                d = std::min(d, m_grid_min_z + (z1+1)*m_grid_cell_size - pz);
+            if (d == 999999.0f)
+                break;
+            d = std::max(d - 0.01f, 0.0f);
+            if (outside_2 + d*d > min_dist_2)
+                break;
+        }   // for r
+        if (min_sector != UNKNOWN_SECTOR)
+            return min_sector;
+    }   // phase
+
+    Log::warn("Graph", "unknown sector found.");
+    return 0;
+}   // findOutOfRoadSectorInGrid
+
+//-----------------------------------------------------------------------------
+/** Sorts all quads into a uniform grid in the x/z plane, which is used by
+ *  findRoadSector and findOutOfRoadSector to only test nearby quads. Must be
+ *  called once all quads are created.
+ */
+void Graph::buildGrid()
+{
+    m_grid_start.clear();
+    m_grid_quads.clear();
+    m_grid_width = m_grid_height = 0;
+    const int n = (int)m_all_nodes.size();
+    if (n == 0) return;
+
+    // The x/z bounding box of each quad. A 3d quad uses a bounding box
+    // (see BoundingBox3D) which extends up to 5 units along its normal, so
+    // it can contain points which are not above or below the quad.
+    std::vector<float> bb(4*n);
+    float min_x = 999999.0f, min_z = 999999.0f;
+    float max_x = -999999.0f, max_z = -999999.0f;
+    float sum_size = 0;
+    for (int i = 0; i < n; i++)
+    {
+        const Quad *q = m_all_nodes[i];
+        const float margin = q->is3DQuad() ? 5.0f : 0.0f;
+        float *b = &bb[4*i];
+        b[0] = b[1] = 999999.0f;
+        b[2] = b[3] = -999999.0f;
+        for (int j = 0; j < 4; j++)
+        {
+            b[0] = std::min(b[0], (*q)[j].getX() - margin);
+            b[1] = std::min(b[1], (*q)[j].getZ() - margin);
+            b[2] = std::max(b[2], (*q)[j].getX() + margin);
+            b[3] = std::max(b[3], (*q)[j].getZ() + margin);
+        }
+        min_x = std::min(min_x, b[0]);
+        min_z = std::min(min_z, b[1]);
+        max_x = std::max(max_x, b[2]);
+        max_z = std::max(max_z, b[3]);
+        sum_size += std::max(b[2] - b[0], b[3] - b[1]);
+    }
+
+    // Cells about the size of an average quad, but not too many of them
+    m_grid_min_x     = min_x;
+    m_grid_min_z     = min_z;
+    m_grid_cell_size = std::max(sum_size / n, 1.0f);
+    while ((max_x - min_x) / m_grid_cell_size *
+           (max_z - min_z) / m_grid_cell_size > 65536.0f)
+        m_grid_cell_size *= 2.0f;
+    m_grid_width  = (int)((max_x - min_x) / m_grid_cell_size) + 1;
+    m_grid_height = (int)((max_z - min_z) / m_grid_cell_size) + 1;
+
+    // Two passes: count the quads per cell, then fill them in. Since the
+    // quads are added in order, each cell is sorted by quad index.
+    m_grid_start.assign(m_grid_width*m_grid_height + 1, 0);
+    for (int pass = 0; pass < 2; pass++)
+    {
+        std::vector<unsigned int> next;
+        if (pass == 1)
+        {
+            for (unsigned int c = 1; c < m_grid_start.size(); c++)
+                m_grid_start[c] += m_grid_start[c - 1];
+            m_grid_quads.resize(m_grid_start.back());
+            next.assign(m_grid_start.begin(), m_grid_start.end() - 1);
+        }
+        for (int i = 0; i < n; i++)
+        {
+            const float *b = &bb[4*i];
+            for (int z = getGridZ(b[1]); z <= getGridZ(b[3]); z++)
+            {
+                for (int x = getGridX(b[0]); x <= getGridX(b[2]); x++)
+                {
+                    const int cell = z*m_grid_width + x;
+                    if (pass == 0)
+                        m_grid_start[cell + 1]++;
+                    else
+                        m_grid_quads[next[cell]++] = i;
+                }
+            }
+        }   // for i < n
+    }   // for pass
+}   // buildGrid
+
 //-----------------------------------------------------------------------------
 void Graph::loadBoundingBoxNodes()
 {
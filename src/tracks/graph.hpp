@@ -24,6 +24,7 @@
 
 #include <dimension2d.h>
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <vector>
@@ -66,6 +67,8 @@ protected:
     // ------------------------------------------------------------------------
     /** Map 4 bounding box points to 4 closest graph nodes. */
     void loadBoundingBoxNodes();
+    // ------------------------------------------------------------------------
+    void buildGrid();
 
 private:
     /** The 2d bounding box, used for hashing. */
@@ -87,6 +90,33 @@ private:
     /** Scaling for mini map. */
     float m_scaling;
 
+    /** A uniform grid in the x/z plane over all quads, which is used to
+     *  speed up findRoadSector and findOutOfRoadSector. The quads
+     *  overlapping cell i are m_grid_quads[m_grid_start[i]] up to (but
+     *  excluding) m_grid_quads[m_grid_start[i+1]], sorted by index. */
+    float m_grid_min_x, m_grid_min_z, m_grid_cell_size;
+    int   m_grid_width, m_grid_height;
+    std::vector<unsigned int> m_grid_start;
+    std::vector<int>          m_grid_quads;
+
+    // ------------------------------------------------------------------------
+    /** Returns the grid column of the x coordinate x, clamped to the grid. */
+    int getGridX(float x) const
+    {
+        int i = (int)floorf((x - m_grid_min_x) / m_grid_cell_size);
+        return i < 0 ? 0 : (i >= m_grid_width ? m_grid_width - 1 : i);
+    }   // getGridX
+    // ------------------------------------------------------------------------
+    /** Returns the grid row of the z coordinate z, clamped to the grid. */
+    int getGridZ(float z) const
+    {
+        int i = (int)floorf((z - m_grid_min_z) / m_grid_cell_size);
+        return i < 0 ? 0 : (i >= m_grid_height ? m_grid_height - 1 : i);
+    }   // getGridZ
+
+    // ------------------------------------------------------------------------
+    int findOutOfRoadSectorInGrid(const Vec3 &xyz, int start,
+                                  bool ignore_vertical) const;
     // ------------------------------------------------------------------------
     void createMesh(bool show_invisible=true,
                     bool enable_transparency=false,
@@ -134,6 +164,15 @@ public:
         }
     }   // destroy
     // ------------------------------------------------------------------------
+    /** Removes the graph without deleting it and returns it, so that it can
+     *  be kept (e.g. by the TrackCache) and set again with setGraph. */
+    static Graph* release()
+    {
+        Graph* graph = m_graph;
+        m_graph = NULL;
+        return graph;
+    }   // release
+    // ------------------------------------------------------------------------
     Graph();
     // ------------------------------------------------------------------------
     virtual ~Graph();
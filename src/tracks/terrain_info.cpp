@@ -33,6 +33,7 @@ TerrainInfo::TerrainInfo()
 {
     m_last_material = NULL;
     m_material      = NULL;
+    m_prepared      = false;
 }   // TerrainInfo
 
 //-----------------------------------------------------------------------------
@@ -44,6 +45,7 @@ TerrainInfo::TerrainInfo(const Vec3 &pos)
     // initialise HoT
     m_last_material = NULL;
     m_material = NULL;
+    m_prepared = false;
     update(pos);
 }   // TerrainInfo
 
@@ -53,6 +55,7 @@ TerrainInfo::TerrainInfo(const Vec3 &pos)
  */
 void TerrainInfo::update(const Vec3 &from)
 {
+    m_prepared      = false;
     m_last_material = m_material;
     btVector3 to(from);
     to.setY(-10000.0f);
@@ -67,7 +70,9 @@ void TerrainInfo::update(const Vec3 &from)
 }   // update
 
 //-----------------------------------------------------------------------------
-/** Update the terrain information based on the latest position.
+/** Update the terrain information based on the latest position. If
+ *  prepareUpdate() was called with the same rotation and start point since
+ *  the last update, its result is used instead of casting the rays again.
  *  \param tran The transform ov the kart
  *  \param from World coordinates from which to start the raycast.
  */
@@ -77,27 +82,73 @@ void TerrainInfo::update(const btMatrix3x3 &rotation, const Vec3 &from)
     // Save the origin for debug drawing
     m_origin_ray    = from;
 
+    if (m_prepared && rotation == m_prepared_rotation &&
+        from.getX() == m_prepared_from.getX() &&
+        from.getY() == m_prepared_from.getY() &&
+        from.getZ() == m_prepared_from.getZ()    )
+    {
+        m_hit_point = m_prepared_hit_point;
+        m_material  = m_prepared_material;
+        m_normal    = m_prepared_normal;
+        m_prepared  = false;
+        return;
+    }
+    m_prepared = false;
+    castRay(rotation, from, &m_hit_point, &m_material, &m_normal);
+}   // update
+
+//-----------------------------------------------------------------------------
+/** Casts the rays for update(rotation, from) in advance and stores the
+ *  result. This only reads the track and the state of this object, so
+ *  it can be called for several objects in parallel.
+ *  \param rotation The rotation the object is expected to have when
+ *         update() is called.
+ *  \param from The expected start point of the raycast.
+ */
+void TerrainInfo::prepareUpdate(const btMatrix3x3 &rotation, const Vec3 &from)
+{
+    // The result of the raycasts can depend on the previous values (e.g. if
+    // nothing is hit), so start with the current data.
+    m_prepared_rotation  = rotation;
+    m_prepared_from      = from;
+    m_prepared_hit_point = m_hit_point;
+    m_prepared_material  = m_material;
+    m_prepared_normal    = m_normal;
+    castRay(rotation, from, &m_prepared_hit_point, &m_prepared_material,
+            &m_prepared_normal);
+    m_prepared = true;
+}   // prepareUpdate
+
+//-----------------------------------------------------------------------------
+/** Casts a ray down (relative to the rotation) against the track and all
+ *  driveable track objects and returns the closest hit.
+ */
+void TerrainInfo::castRay(const btMatrix3x3 &rotation, const Vec3 &from,
+                          Vec3 *hit_point, const Material **material,
+                          Vec3 *normal) const
+{
     // Compute the 'to' vector by rotating a long 'down' vectory by the
     // kart rotation, and adding the start point to it.
     btVector3 to(0, -10000.0f, 0);
     to = from + rotation*to;
 
     const TriangleMesh &tm = Track::getCurrentTrack()->getTriangleMesh();
-    tm.castRay(from, to, &m_hit_point, &m_material, &m_normal,
+    tm.castRay(from, to, hit_point, material, normal,
                /*interpolate*/true);
     // Now also raycast against all track objects (that are driveable). If
     // there should be a closer result (than the one against the main track 
     // mesh), its data will be returned.
     Track::getCurrentTrack()->getTrackObjectManager()
-                            ->castRay(from, to, &m_hit_point, &m_material,
-                                      &m_normal, /*interpolate*/true);
-}   // update
+                            ->castRay(from, to, hit_point, material,
+                                      normal, /*interpolate*/true);
+}   // castRay
 //-----------------------------------------------------------------------------
 /** Update the terrain information based on the latest position.
 *  \param Position from which to start the rayast from.
 */
 void TerrainInfo::update(const Vec3 &from, const Vec3 &towards)
 {
+    m_prepared      = false;
     m_last_material = m_material;
     Vec3 direction = towards.normalized();
     btVector3 to = from + 10000.0f*direction;
@@ -21,6 +21,8 @@
 
 #include "utils/vec3.hpp"
 
+#include "LinearMath/btMatrix3x3.h"
+
 class btTransform;
 class Material;
 
@@ -43,6 +45,20 @@ private:
     /** DEBUG only: origin of raycast. */
     Vec3 m_origin_ray;
 
+    /** Inputs and results of a raycast that was done in advance by
+     *  prepareUpdate(). They are used by the next update(rotation, from)
+     *  if it is called with exactly the same inputs. */
+    bool              m_prepared;
+    btMatrix3x3       m_prepared_rotation;
+    Vec3              m_prepared_from;
+    Vec3              m_prepared_normal;
+    const Material   *m_prepared_material;
+    Vec3              m_prepared_hit_point;
+
+    void     castRay(const btMatrix3x3 &rotation, const Vec3 &from,
+                     Vec3 *hit_point, const Material **material,
+                     Vec3 *normal) const;
+
 public:
              TerrainInfo();
              TerrainInfo(const Vec3 &pos);
@@ -51,6 +67,7 @@ public:
     bool     getSurfaceInfo(const Vec3 &from, Vec3 *position,
                             const Material **m);
     virtual void update(const btMatrix3x3 &rotation, const Vec3 &from);
+    void     prepareUpdate(const btMatrix3x3 &rotation, const Vec3 &from);
     virtual void update(const Vec3 &from);
     virtual void update(const Vec3 &from, const Vec3 &towards);
 
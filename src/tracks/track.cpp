@@ -65,12 +65,14 @@
 #include "tracks/drive_graph.hpp"
 #include "tracks/drive_node.hpp"
 #include "tracks/model_definition_loader.hpp"
+#include "tracks/track_cache.hpp"
 #include "tracks/track_manager.hpp"
 #include "tracks/track_object_manager.hpp"
 #include "utils/constants.hpp"
 #include "utils/log.hpp"
 #include "utils/mini_glm.hpp"
 #include "utils/objecttype.h"
+#include "utils/random_generator.hpp"
 #include "utils/string_utils.hpp"
 
 #include <IBillboardTextSceneNode.h>
@@ -82,6 +84,7 @@
 #include <SMeshBuffer.h>
 
 #include <iostream>
+#include <set>
 #include <stdexcept>
 #include <sstream>
 #include <wchar.h>
@@ -264,7 +267,18 @@ void Track::cleanup()
     file_manager->popTextureSearchPath();
     file_manager->popModelSearchPath();
 
-    Graph::destroy();
+    // With the track cache, the graph, the bvh of the track mesh and all
+    // meshes this track added to irrlicht's mesh cache are kept for the next
+    // race on this track. The cache grabs the meshes, so the loops below
+    // will not remove them from the mesh cache.
+    if (TrackCache::get())
+    {
+        TrackCache::get()->store(m_track_cache_key, m_track_cache_meshes,
+                                 Graph::release(), m_track_mesh);
+        m_track_cache_meshes.clear();
+    }
+    else
+        Graph::destroy();
     ItemManager::destroy();
 #ifndef SERVER_ONLY
     if (CVS->isGLSL())
@@ -591,7 +605,10 @@ void Track::startMusic() const
  */
 void Track::loadArenaGraph(const XMLNode &node)
 {
-    ArenaGraph* graph = new ArenaGraph(m_root+"navmesh.xml", &node);
+    Graph* graph = TrackCache::get()
+                 ? TrackCache::get()->takeGraph(m_track_cache_key) : NULL;
+    if (!graph)
+        graph = new ArenaGraph(m_root+"navmesh.xml", &node);
     Graph::setGraph(graph);
 
     if(Graph::get()->getNumNodes()==0)
@@ -631,12 +648,25 @@ btQuaternion Track::getArenaStartRotation(const Vec3& xyz, float heading)
  */
 void Track::loadDriveGraph(unsigned int mode_id, const bool reverse)
 {
-    new DriveGraph(m_root+m_all_modes[mode_id].m_quad_name,
-        m_root+m_all_modes[mode_id].m_graph_name, reverse);
+    Graph* graph = TrackCache::get()
+                 ? TrackCache::get()->takeGraph(m_track_cache_key) : NULL;
+    if (graph)
+    {
+        // The checkline requirements depend on the race mode, they are
+        // computed again if needed.
+        Graph::setGraph(graph);
+        assert(DriveGraph::get());
+        DriveGraph::get()->resetChecklineRequirements();
+    }
+    else
+    {
+        new DriveGraph(m_root+m_all_modes[mode_id].m_quad_name,
+            m_root+m_all_modes[mode_id].m_graph_name, reverse);
 
-    // setGraph is done in DriveGraph constructor
-    assert(DriveGraph::get());
-    DriveGraph::get()->setupPaths();
+        // setGraph is done in DriveGraph constructor
+        assert(DriveGraph::get());
+        DriveGraph::get()->setupPaths();
+    }
 #ifdef DEBUG
     for(unsigned int i=0; i<DriveGraph::get()->getNumNodes(); i++)
     {
@@ -705,7 +735,12 @@ void Track::createPhysicsModel(unsigned int main_track_count)
         convertTrackToBullet(m_all_nodes[i]);
         uploadNodeVertexBuffer(m_all_nodes[i]);
     }
-    m_track_mesh->createPhysicalBody(m_friction);
+    // Reuse the bvh of the last race on this track if the triangles match.
+    const std::string *bvh = TrackCache::get()
+        ? TrackCache::get()->getBvh(m_track_cache_key, *m_track_mesh) : NULL;
+    m_track_mesh->createPhysicalBody(m_friction,
+                                     (btCollisionObject::CollisionFlags)0,
+                                     NULL, bvh);
     m_gfx_effect_mesh->createCollisionShape();
 }   // createPhysicsModel
 
@@ -1456,6 +1491,21 @@ void Track::loadTrackModel(bool reverse_track, unsigned int mode_id)
     CheckManager::create();
     assert(m_all_cached_meshes.size()==0);
 
+    // Remember which meshes are in irrlicht's mesh cache before loading, so
+    // that the meshes added by this track can be handed to the track cache.
+    std::set<scene::IAnimatedMesh*> meshes_before_load;
+    scene::IMeshCache *mesh_cache =
+        irr_driver->getSceneManager()->getMeshCache();
+    if (TrackCache::get())
+    {
+        // The arena graph of soccer fields also contains the goal nodes.
+        m_track_cache_key = StringUtils::insertValues("%s/%d%s%s",
+            m_ident.c_str(), mode_id, reverse_track ? "/reverse" : "",
+            race_manager->isSoccerMode() ? "/soccer" : "");
+        for (unsigned int i = 0; i < mesh_cache->getMeshCount(); i++)
+            meshes_before_load.insert(mesh_cache->getMeshByIndex(i));
+    }
+
     CameraEnd::clearEndCameras();
     m_sky_type             = SKY_NONE;
     m_track_object_manager = new TrackObjectManager();
@@ -1539,11 +1589,14 @@ void Track::loadTrackModel(bool reverse_track, unsigned int mode_id)
         loadArenaGraph(*root);
 
     {
-        // Seed random engine locally
-        uint32_t seed = (uint32_t)StkTime::getTimeSinceEpoch();
-        ItemManager::updateRandomSeed(seed);
+        // Seed the item and powerup streams from the race seed, they are
+        // re-seeded in World::reset
+        uint32_t seed = race_manager->getRandomSeed();
+        ItemManager::updateRandomSeed(
+            RandomGenerator::deriveSeed(seed, RandomGenerator::RS_ITEMS));
         ItemManager::create();
-        powerup_manager->setRandomSeed(seed);
+        powerup_manager->setRandomSeed(
+            RandomGenerator::deriveSeed(seed, RandomGenerator::RS_POWERUPS));
     }
 
     // Set the default start positions. Node that later the default
@@ -1844,6 +1897,17 @@ void Track::loadTrackModel(bool reverse_track, unsigned int mode_id)
     }
 
     STKTexManager::getInstance()->unsetTextureErrorMessage();
+
+    if (TrackCache::get())
+    {
+        assert(m_track_cache_meshes.empty());
+        for (unsigned int i = 0; i < mesh_cache->getMeshCount(); i++)
+        {
+            scene::IAnimatedMesh *mesh = mesh_cache->getMeshByIndex(i);
+            if (meshes_before_load.count(mesh) == 0)
+                m_track_cache_meshes.push_back(mesh->getMesh(0));
+        }
+    }
 #ifndef SERVER_ONLY
     if (CVS->isGLSL())
     {
@@ -1940,7 +2004,9 @@ void Track::loadObjects(const XMLNode* root, const std::string& path,
         }
         else if (name == "sky-dome" || name == "sky-box" || name == "sky-color")
         {
-            handleSky(*node, path);
+            // The sky textures are never used without rendering
+            if (!UserConfigParams::m_physics_only)
+                handleSky(*node, path);
         }
         else if (name == "end-cameras")
         {
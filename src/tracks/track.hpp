@@ -121,6 +121,14 @@ private:
       */
     std::vector<scene::IMesh*>      m_detached_cached_meshes;
 
+    /** The key of this track (identifier, mode and direction) in the
+     *  TrackCache, only used if the track cache is enabled. */
+    std::string                     m_track_cache_key;
+
+    /** Meshes that were added to irrlicht's mesh cache while loading this
+     *  track, they are handed to the TrackCache at cleanup time. */
+    std::vector<scene::IMesh*>      m_track_cache_meshes;
+
     /** A list of all textures loaded by the track, so that they can
      *  be removed from the cache at cleanup time. */
     std::vector<video::ITexture*>   m_all_cached_textures;
@@ -0,0 +1,234 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2006-2015 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#include "tracks/track_cache.hpp"
+
+#include "graphics/irr_driver.hpp"
+#include "physics/triangle_mesh.hpp"
+#include "tracks/arena_graph.hpp"
+#include "tracks/arena_node.hpp"
+#include "tracks/drive_graph.hpp"
+#include "tracks/drive_node.hpp"
+#include "utils/log.hpp"
+
+#include <IMesh.h>
+#include <IMeshCache.h>
+#include <IMeshBuffer.h>
+#include <ISceneManager.h>
+
+TrackCache *TrackCache::m_track_cache = NULL;
+
+// ----------------------------------------------------------------------------
+TrackCache::~TrackCache()
+{
+    for (Entry *entry : m_entries)
+        freeEntry(entry);
+    m_entries.clear();
+}   // ~TrackCache
+
+// ----------------------------------------------------------------------------
+/** Returns the entry for the given key and marks it as most recently used,
+ *  or returns NULL if the track is not cached.
+ *  \param key The track identifier, mode and direction.
+ */
+TrackCache::Entry* TrackCache::find(const std::string &key)
+{
+    for (std::list<Entry*>::iterator i = m_entries.begin();
+         i != m_entries.end(); i++)
+    {
+        if ((*i)->m_key != key) continue;
+        Entry *entry = *i;
+        if (i != m_entries.begin())
+            m_entries.splice(m_entries.begin(), m_entries, i);
+        return entry;
+    }
+    return NULL;
+}   // find
+
+// ----------------------------------------------------------------------------
+/** Returns the cached graph of a track and removes it from the cache (it is
+ *  stored again when the track is cleaned up), or NULL if there is none.
+ *  \param key The track identifier, mode and direction.
+ */
+Graph* TrackCache::takeGraph(const std::string &key)
+{
+    Entry *entry = find(key);
+    if (!entry)
+        return NULL;
+    Graph *graph = entry->m_graph;
+    entry->m_graph = NULL;
+    return graph;
+}   // takeGraph
+
+// ----------------------------------------------------------------------------
+/** Returns the cached bvh of a track if it was computed for exactly the
+ *  triangles in track_mesh, otherwise NULL.
+ *  \param key The track identifier, mode and direction.
+ *  \param track_mesh The (complete) collision mesh of the track.
+ */
+const std::string* TrackCache::getBvh(const std::string &key,
+                                      const TriangleMesh &track_mesh)
+{
+    Entry *entry = find(key);
+    if (!entry || entry->m_bvh.empty() ||
+        entry->m_bvh_triangles != track_mesh.getNumTriangles() ||
+        entry->m_bvh_hash != track_mesh.getVertexHash())
+        return NULL;
+    return &entry->m_bvh;
+}   // getBvh
+
+// ----------------------------------------------------------------------------
+/** Adds the data of a track that is being cleaned up to the cache. If the
+ *  track is cached already, the new meshes are added to the existing entry
+ *  and a graph or bvh is only stored if the entry does not have one. Then
+ *  least recently used entries are evicted until the cache fits into the
+ *  budget.
+ *  \param key The track identifier, mode and direction.
+ *  \param meshes Meshes loaded by the track that are in irrlicht's mesh
+ *         cache. They are grabbed, together with their textures.
+ *  \param graph The graph of the track (can be NULL), the cache takes
+ *         ownership.
+ *  \param track_mesh The collision mesh of the track (can be NULL), its bvh
+ *         is serialized if the entry does not have one yet.
+ */
+void TrackCache::store(const std::string &key,
+                       const std::vector<scene::IMesh*> &meshes,
+                       Graph *graph, const TriangleMesh *track_mesh)
+{
+    Entry *entry = find(key);
+    if (!entry)
+    {
+        entry = new Entry();
+        entry->m_key           = key;
+        entry->m_graph         = NULL;
+        entry->m_bvh_triangles = 0;
+        entry->m_bvh_hash      = 0;
+        entry->m_size          = 0;
+        m_entries.push_front(entry);
+    }
+
+    scene::IMeshCache *mesh_cache =
+        irr_driver->getSceneManager()->getMeshCache();
+    for (scene::IMesh *mesh : meshes)
+    {
+        // Meshes that were already removed from the mesh cache (e.g. to be
+        // replaced by a modified copy) can't be found again.
+        if (mesh_cache->getMeshIndex(mesh) == -1)
+            continue;
+        mesh->grab();
+#ifndef SERVER_ONLY
+        irr_driver->grabAllTextures(mesh);
+#endif
+        entry->m_meshes.push_back(mesh);
+    }
+
+    if (!entry->m_graph)
+        entry->m_graph = graph;
+    else
+        delete graph;
+
+    if (track_mesh && entry->m_bvh.empty() &&
+        track_mesh->serializeBvh(&entry->m_bvh))
+    {
+        entry->m_bvh_triangles = track_mesh->getNumTriangles();
+        entry->m_bvh_hash      = track_mesh->getVertexHash();
+    }
+
+    computeSize(entry);
+    shrink();
+}   // store
+
+// ----------------------------------------------------------------------------
+/** Evicts least recently used entries until the estimated memory of all
+ *  entries fits into the budget.
+ */
+void TrackCache::shrink()
+{
+    size_t total = 0;
+    for (Entry *entry : m_entries)
+        total += entry->m_size;
+
+    while (total > m_budget && !m_entries.empty())
+    {
+        Entry *entry = m_entries.back();
+        m_entries.pop_back();
+        total -= entry->m_size;
+        Log::info("TrackCache", "Evicting '%s' (%zu kB).",
+                  entry->m_key.c_str(), entry->m_size / 1024);
+        freeEntry(entry);
+    }
+}   // shrink
+
+// ----------------------------------------------------------------------------
+/** Estimates the memory used by an entry: vertex and index data of all
+ *  meshes, the graph nodes (and distance tables of an arena graph) and the
+ *  bvh. Textures are shared between tracks and are not counted.
+ */
+void TrackCache::computeSize(Entry *entry)
+{
+    size_t size = entry->m_bvh.size();
+    for (scene::IMesh *mesh : entry->m_meshes)
+    {
+        for (unsigned int i = 0; i < mesh->getMeshBufferCount(); i++)
+        {
+            const scene::IMeshBuffer *mb = mesh->getMeshBuffer(i);
+            size += mb->getVertexCount() *
+                    video::getVertexPitchFromType(mb->getVertexType());
+            size += mb->getIndexCount() *
+                    (mb->getIndexType() == video::EIT_16BIT ? 2 : 4);
+        }
+    }
+
+    if (entry->m_graph)
+    {
+        size_t n = entry->m_graph->getNumNodes();
+        if (dynamic_cast<ArenaGraph*>(entry->m_graph))
+            size += n * sizeof(ArenaNode) + n * n * (sizeof(float) +
+                                                     sizeof(int16_t));
+        else
+            size += n * sizeof(DriveNode);
+    }
+    entry->m_size = size;
+}   // computeSize
+
+// ----------------------------------------------------------------------------
+/** Frees all data of an entry. Meshes are dropped the same way the track
+ *  drops them in Track::cleanup, so they are only removed from irrlicht's
+ *  mesh cache if no other track or object is still using them.
+ */
+void TrackCache::freeEntry(Entry *entry)
+{
+    for (scene::IMesh *mesh : entry->m_meshes)
+    {
+#ifndef SERVER_ONLY
+        irr_driver->dropAllTextures(mesh);
+#endif
+        if (mesh->getReferenceCount() == 1)
+        {
+            mesh->drop();
+            continue;
+        }
+        mesh->drop();
+        if (mesh->getReferenceCount() == 1)
+            irr_driver->removeMeshFromCache(mesh);
+    }
+    delete entry->m_graph;
+    delete entry;
+}   // freeEntry
+
+/* EOF */
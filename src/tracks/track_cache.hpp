@@ -0,0 +1,119 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2006-2015 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef HEADER_TRACK_CACHE_HPP
+#define HEADER_TRACK_CACHE_HPP
+
+#include "utils/no_copy.hpp"
+
+#include <assert.h>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace irr
+{
+    namespace scene { class IMesh; }
+}
+using namespace irr;
+
+class Graph;
+class TriangleMesh;
+
+/**
+ * \brief Keeps the data of recently used tracks alive between races.
+ *  When a track is cleaned up, the meshes it loaded into irrlicht's mesh
+ *  cache (including their SP mesh buffers and textures), its drive or arena
+ *  graph and the bvh of its collision mesh are stored here instead of being
+ *  freed. The next time the same track (with the same mode and direction)
+ *  is loaded, the meshes are found in the mesh cache, and the graph and bvh
+ *  are reused instead of being rebuilt. Scene nodes and track objects are
+ *  still created for each race.
+ *  Entries are evicted least recently used first once the estimated memory
+ *  of all entries exceeds the budget. The estimate counts vertex and index
+ *  data, graphs and bvhs, but not textures.
+ * \ingroup tracks
+ */
+class TrackCache : public NoCopy
+{
+public:
+    /** The cached data of one track. */
+    struct Entry
+    {
+        /** The track identifier, mode and direction. */
+        std::string                m_key;
+        /** Meshes kept in irrlicht's mesh cache (grabbed once each). */
+        std::vector<scene::IMesh*> m_meshes;
+        /** The drive or arena graph, or NULL while it is used in a race. */
+        Graph                     *m_graph;
+        /** The serialized bvh of the track's collision mesh. */
+        std::string                m_bvh;
+        /** Number of triangles and vertex hash the bvh was computed for. */
+        unsigned int               m_bvh_triangles;
+        uint64_t                   m_bvh_hash;
+        /** Estimated memory used by this entry in bytes. */
+        size_t                     m_size;
+    };   // Entry
+
+private:
+    static TrackCache *m_track_cache;
+
+    /** All entries, most recently used first. */
+    std::list<Entry*> m_entries;
+
+    /** Maximum estimated memory of all entries in bytes. */
+    size_t m_budget;
+
+    TrackCache(size_t budget) : m_budget(budget) {}
+    ~TrackCache();
+    void freeEntry(Entry *entry);
+    void computeSize(Entry *entry);
+
+public:
+    // ------------------------------------------------------------------------
+    /** Creates the track cache with the given budget in bytes. */
+    static void create(size_t budget)
+    {
+        assert(!m_track_cache);
+        m_track_cache = new TrackCache(budget);
+    }   // create
+    // ------------------------------------------------------------------------
+    /** Returns the track cache, or NULL if caching is disabled. */
+    static TrackCache* get() { return m_track_cache; }
+    // ------------------------------------------------------------------------
+    /** Frees all cached data and the track cache. */
+    static void destroy() { delete m_track_cache; m_track_cache = NULL; }
+    // ------------------------------------------------------------------------
+    Entry*             find(const std::string &key);
+    // ------------------------------------------------------------------------
+    Graph*             takeGraph(const std::string &key);
+    // ------------------------------------------------------------------------
+    const std::string* getBvh(const std::string &key,
+                              const TriangleMesh &track_mesh);
+    // ------------------------------------------------------------------------
+    void               store(const std::string &key,
+                             const std::vector<scene::IMesh*> &meshes,
+                             Graph *graph, const TriangleMesh *track_mesh);
+    // ------------------------------------------------------------------------
+    void               shrink();
+};   // TrackCache
+
+#endif
+
+/* EOF */
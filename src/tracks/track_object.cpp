@@ -453,6 +453,9 @@ void TrackObject::onWorldReady()
     }
     if (!m_initially_visible)
         setEnabled(false);
+
+    if (m_physical_object)
+        m_physical_object->resolveScripts();
 }
 
 // ----------------------------------------------------------------------------
@@ -27,6 +27,7 @@
 #include "physics/physical_object.hpp"
 #include "tracks/track_object.hpp"
 #include "utils/log.hpp"
+#include "utils/snapshot.hpp"
 
 #include <IMeshSceneNode.h>
 #include <ISceneManager.h>
@@ -104,6 +105,32 @@ void TrackObjectManager::reset()
     }
 }   // reset
 
+// ----------------------------------------------------------------------------
+/** Saves the state of all animated and dynamic physical objects. */
+void TrackObjectManager::saveState(Snapshot *s) const
+{
+    for (const TrackObject* curr : m_all_objects)
+    {
+        if (curr->getAnimator())
+            curr->getAnimator()->saveState(s);
+        if (curr->getPhysicalObject())
+            curr->getPhysicalObject()->saveState(s);
+    }
+}   // saveState
+
+// ----------------------------------------------------------------------------
+/** Restores the state of all objects saved with saveState. */
+void TrackObjectManager::restoreState(Snapshot *s)
+{
+    for (TrackObject* curr : m_all_objects)
+    {
+        if (curr->getAnimator())
+            curr->getAnimator()->restoreState(s);
+        if (curr->getPhysicalObject())
+            curr->getPhysicalObject()->restoreState(s);
+    }
+}   // restoreState
+
 // ----------------------------------------------------------------------------
 /** returns a reference to the track object
  *  with a particular ID
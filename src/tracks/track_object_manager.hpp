@@ -23,6 +23,7 @@
 #include "tracks/track_object.hpp"
 #include "utils/ptr_vector.hpp"
 
+class Snapshot;
 class Track;
 class Vec3;
 class XMLNode;
@@ -55,6 +56,8 @@ public:
          TrackObjectManager();
         ~TrackObjectManager();
     void reset();
+    void saveState(Snapshot *s) const;
+    void restoreState(Snapshot *s);
     void init();
     void add(const XMLNode &xml_node, scene::ISceneNode* parent,
              ModelDefinitionLoader& model_def_loader,
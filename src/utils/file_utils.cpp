@@ -19,10 +19,17 @@
 #include "utils/log.hpp"
 #include "utils/string_utils.hpp"
 
+#include <atomic>
 #include <stdio.h>
 #include <string>
 #include <sys/stat.h>
 
+#if defined(WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
 // ----------------------------------------------------------------------------
 #if defined(WIN32)
 #include <windows.h>
@@ -166,3 +173,83 @@ int FileUtils::renameU8Path(const std::string& u8_path_old,
     return rename(u8_path_old.c_str(), u8_path_new.c_str());
 #endif
 }   // renameU8Path
+
+// ----------------------------------------------------------------------------
+/** Returns a hash (FNV-1a) of some bytes. Pass the hash of other bytes to
+ *  hash all of them.
+ */
+uint64_t FileUtils::hashBytes(const void* data, size_t size, uint64_t hash)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}   // hashBytes
+
+// ----------------------------------------------------------------------------
+/** Returns a hash (FNV-1a) of the content of a file, or 0 if it can't be
+ *  read. Pass the hash of another file to hash the content of both.
+ */
+uint64_t FileUtils::hashFile(const std::string& u8_path, uint64_t hash)
+{
+    FILE* f = fopenU8Path(u8_path, "rb");
+    if (!f)
+        return 0;
+    unsigned char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0)
+        hash = hashBytes(buffer, n, hash);
+    fclose(f);
+    return hash;
+}   // hashFile
+
+// ----------------------------------------------------------------------------
+/** Writes a file so that other processes see either the old or the complete
+ *  new file, never a partially written one: the content is written to a
+ *  temporary file next to it, which then replaces the file.
+ *  \param u8_path The file to write, its directory must exist.
+ *  \param write Writes the content, returns false if that failed.
+ *  
+eturn True if the file was written.
+ */
+bool FileUtils::writeFileAtomic(const std::string& u8_path,
+                                const std::function<bool(FILE*)>& write)
+{
+    // The process id and a counter make the name unique, even if several
+    // processes or threads write the same file
+    static std::atomic<unsigned> counter(0);
+#if defined(WIN32)
+    const int pid = _getpid();
+#else
+    const int pid = getpid();
+#endif
+    const std::string tmp_path = u8_path + "." + StringUtils::toString(pid) +
+        "." + StringUtils::toString(counter++) + ".tmp";
+    FILE* f = fopenU8Path(tmp_path, "wb");
+    if (!f)
+        return false;
+    bool success = write(f);
+    success = fclose(f) == 0 && success;
+#if defined(WIN32)
+    // _wrename does not replace an existing file
+    success = success &&
+        MoveFileExW(StringUtils::utf8ToWide(tmp_path).c_str(),
+                    StringUtils::utf8ToWide(u8_path).c_str(),
+                    MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    // rename atomically replaces an existing file
+    success = success && renameU8Path(tmp_path, u8_path) == 0;
+#endif
+    if (!success)
+    {
+#if defined(WIN32)
+        _wremove(StringUtils::utf8ToWide(tmp_path).c_str());
+#else
+        remove(tmp_path.c_str());
+#endif
+    }
+    return success;
+}   // writeFileAtomic
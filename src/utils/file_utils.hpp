@@ -18,6 +18,8 @@
 #ifndef HEADER_FILE_UTILS_HPP
 #define HEADER_FILE_UTILS_HPP
 
+#include <cstdint>
+#include <functional>
 #include <stdio.h>
 #include <string>
 #include <sys/stat.h>
@@ -39,6 +41,15 @@ namespace FileUtils
     int renameU8Path(const std::string& u8_path_old,
                      const std::string& u8_path_new);
     // ------------------------------------------------------------------------
+    uint64_t hashBytes(const void* data, size_t size,
+                       uint64_t hash = 14695981039346656037ULL);
+    // ------------------------------------------------------------------------
+    uint64_t hashFile(const std::string& u8_path,
+                      uint64_t hash = 14695981039346656037ULL);
+    // ------------------------------------------------------------------------
+    bool writeFileAtomic(const std::string& u8_path,
+                         const std::function<bool(FILE*)>& write);
+    // ------------------------------------------------------------------------
     /* Return a path which can be opened for writing in all systems, as long as
      * u8_path is unicode encoded. */
     inline std::string getPortableWritingPath(const std::string& u8_path)
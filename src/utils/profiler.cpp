@@ -17,33 +17,17 @@
 
 #include "profiler.hpp"
 
-#include "graphics/glwrap.hpp"
-#include "graphics/irr_driver.hpp"
-#include "graphics/2dutils.hpp"
-#include "graphics/irr_driver.hpp"
-#include "io/file_manager.hpp"
-#include "utils/file_utils.hpp"
-#include "utils/string_utils.hpp"
-#include "utils/vs.hpp"
-
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <fstream>
-#include <ostream>
-#include <stack>
 #include <sstream>
+#include <stdexcept>
 
 Profiler profiler;
 
-// Unit is in pencentage of the screen dimensions
-#define MARGIN_X    0.02f    // left and right margin
-#define MARGIN_Y    0.02f    // top margin
-#define LINE_HEIGHT 0.030f   // height of a line representing a thread
-
-#define MARKERS_NAMES_POS     core::rect<s32>(50,100,150,600)
-#define GPU_MARKERS_NAMES_POS core::rect<s32>(50,165,150,300)
-
-// The width of the profiler corresponds to TIME_DRAWN_MS milliseconds
-#define TIME_DRAWN_MS 30.0f 
+/** The data of the calling thread, see Profiler::getThreadData. */
+static thread_local void *g_thread_data = NULL;
 
 // --- Begin portable precise timer ---
 #ifdef WIN32
@@ -62,12 +46,12 @@ Profiler profiler;
     }   // getTimeMilliseconds
 
 #else
-    #include <sys/time.h>
+    #include <time.h>
     double getTimeMilliseconds()
     {
-        struct timeval tv;
-        gettimeofday(&tv, NULL);
-        return double(tv.tv_sec * 1000) + (double(tv.tv_usec) / 1000.0);
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return double(ts.tv_sec) * 1000.0 + double(ts.tv_nsec) / 1000000.0;
     }   // getTimeMilliseconds
 #endif
 // --- End portable precise timer ---
@@ -75,14 +59,13 @@ Profiler profiler;
 //-----------------------------------------------------------------------------
 Profiler::Profiler()
 {
-    m_time_last_sync      = getTimeMilliseconds();
-    m_time_between_sync   = 0.0;
-    m_freeze_state        = UNFROZEN;
-
-    m_max_frames          = 20 * 120;
-    m_current_frame       = 0;
-    m_has_wrapped_around  = false;
-    m_threads_used = 1;
+    m_enabled              = false;
+    m_generation           = 0;
+    m_trace                = false;
+    m_num_trace_events     = 0;
+    m_dropped_trace_events = 0;
+    m_max_trace_events     = 0;
+    m_time_origin          = getTimeMilliseconds();
 }   // Profile
 
 //-----------------------------------------------------------------------------
@@ -91,129 +74,252 @@ Profiler::~Profiler()
 }   // ~Profiler
 
 //-----------------------------------------------------------------------------
-/** It is split from the constructor so that it can be avoided allocating
- *  unnecessary memory when the profiler is never used (for example in no
- *  graphics). */
-void Profiler::init()
+/** Starts recording markers. Data recorded before is kept, see reset().
+ *  \param trace If true each event is recorded for the trace export.
+ *  \param max_trace_events Maximum number of events recorded for the trace,
+ *         later events are only counted in the statistics.
+ */
+void Profiler::enable(bool trace, size_t max_trace_events)
 {
-    const int MAX_THREADS = 10;
-    m_all_threads_data.resize(MAX_THREADS);
-    m_thread_mapping.resize(MAX_THREADS);
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_trace            = trace;
+    m_max_trace_events = max_trace_events;
+    m_generation++;
+    m_enabled          = true;
+}   // enable
 
-    // Add this thread to the thread mapping
-    m_thread_mapping[0] = std::this_thread::get_id();
-    m_gpu_times.resize(Q_LAST * m_max_frames);
-}   // init
+//-----------------------------------------------------------------------------
+/** Stops recording markers. The collected data is kept. */
+void Profiler::disable()
+{
+    m_enabled = false;
+    m_generation++;
+}   // disable
 
 //-----------------------------------------------------------------------------
-/** Returns a unique index for a thread. If the calling thread is not yet in
- *  the mapping, it will assign a new unique id to this thread. This function
- *  is NOT thread-safe and must be called from a properly protected code
- *  section. */
-int Profiler::getThreadID()
+/** Removes all collected statistics and trace events. */
+void Profiler::reset()
 {
-    std::thread::id thread = std::this_thread::get_id();
-    int i = 0;
-    while(i < m_threads_used)
+    std::lock_guard<std::mutex> lock(m_lock);
+    for (auto &td : m_all_thread_data)
     {
-        if (memcmp( &m_thread_mapping[i],
-                    &thread,
-                    sizeof(thread)) ==0 )
-        {
-            return i;
-        }
-        i++;
-    }   // for i <m_threads_used
+        std::lock_guard<std::mutex> thread_lock(td->m_lock);
+        td->m_event_data.clear();
+        td->m_trace_events.clear();
+    }
+    m_num_trace_events     = 0;
+    m_dropped_trace_events = 0;
+    m_time_origin = getTimeMilliseconds();
+}   // reset
+
+//-----------------------------------------------------------------------------
+/** Returns the data of the calling thread, it is created the first time a
+ *  thread pushes a marker. It is kept when the thread ends, so that its
+ *  markers stay in the statistics.
+ */
+Profiler::ThreadData *Profiler::getThreadData()
+{
+    if (!g_thread_data)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        ThreadData *td = new ThreadData();
+        td->m_thread = (int)m_all_thread_data.size();
+        td->m_generation = 0;
+        m_all_thread_data.emplace_back(td);
+        g_thread_data = td;
+    }
+    return (ThreadData*)g_thread_data;
+}   // getThreadData
 
-    assert(m_threads_used < (int)m_thread_mapping.size());
-    m_thread_mapping[m_threads_used] = thread;
-    m_threads_used++;
+//-----------------------------------------------------------------------------
+/** Returns the index of a marker name, which can be passed to
+ *  pushCPUMarker. The name is copied. */
+int Profiler::getEventIndex(const char* name)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto it = m_event_index.find(name);
+    if (it != m_event_index.end())
+        return it->second;
+    int index = (int)m_all_event_names.size();
+    m_event_index[name] = index;
+    m_all_event_names.push_back(name);
+    return index;
+}   // getEventIndex
 
-    return m_threads_used - 1;
-}   // getThreadID
+//-----------------------------------------------------------------------------
+/// Push a new marker that starts now, see getEventIndex
+void Profiler::pushCPUMarker(int event)
+{
+    ThreadData *td = getThreadData();
+    const unsigned int generation = m_generation;
+    if (td->m_generation != generation)
+    {
+        td->m_stack.clear();
+        td->m_generation = generation;
+    }
+    td->m_stack.emplace_back(event, getTimeMilliseconds());
+}   // pushCPUMarker
 
 //-----------------------------------------------------------------------------
-/// Push a new marker that starts now
-void Profiler::pushCPUMarker(const char* name, const video::SColor& colour)
+/// Push a new marker that starts now, for names that are not constant
+void Profiler::pushCPUMarker(const char* name)
 {
+    pushCPUMarker(getEventIndex(name));
 }   // pushCPUMarker
 
 //-----------------------------------------------------------------------------
 /// Stop the last pushed marker
 void Profiler::popCPUMarker()
 {
+    ThreadData *td = getThreadData();
+    // Ignore markers pushed before the profiler was enabled or disabled
+    if (td->m_stack.empty() || td->m_generation != m_generation)
+    {
+        td->m_stack.clear();
+        return;
+    }
+    const double end = getTimeMilliseconds();
+    const int index = td->m_stack.back().first;
+    const double start = td->m_stack.back().second;
+    const double duration = end - start;
+    td->m_stack.pop_back();
+
+    int bucket = 0;
+    if (duration >= 0.001)
+    {
+        bucket = 1 + (int)floor(log10(duration * 1000.0) * BUCKETS_PER_DECADE);
+        bucket = std::min(bucket, NUM_BUCKETS - 1);
+    }
+
+    std::lock_guard<std::mutex> lock(td->m_lock);
+    if (index >= (int)td->m_event_data.size())
+        td->m_event_data.resize(index + 1);
+    EventData &ed = td->m_event_data[index];
+    ed.m_count++;
+    ed.m_total += duration;
+    ed.m_max = std::max(ed.m_max, duration);
+    ed.m_histogram[bucket]++;
+    if (m_trace)
+    {
+        if (m_num_trace_events++ < m_max_trace_events)
+        {
+            TraceEvent te;
+            te.m_event    = index;
+            te.m_thread   = td->m_thread;
+            te.m_start    = start;
+            te.m_duration = duration;
+            td->m_trace_events.push_back(te);
+        }
+        else
+            m_dropped_trace_events++;
+    }
 }   // popCPUMarker
 
 //-----------------------------------------------------------------------------
-/** Switches the profiler either on or off.
+/** Returns the statistics of all markers that were recorded at least once.
+ *  The percentiles are estimated from the histogram.
  */
-void Profiler::toggleStatus()
+std::vector<Profiler::MarkerStats> Profiler::getStats()
 {
-}   // toggleStatus
+    std::lock_guard<std::mutex> lock(m_lock);
+    // Sum up the data of all threads
+    std::vector<EventData> all_event_data(m_all_event_names.size());
+    for (auto &td : m_all_thread_data)
+    {
+        std::lock_guard<std::mutex> thread_lock(td->m_lock);
+        for (unsigned int i = 0; i < td->m_event_data.size(); i++)
+        {
+            const EventData &from = td->m_event_data[i];
+            EventData &to = all_event_data[i];
+            to.m_count += from.m_count;
+            to.m_total += from.m_total;
+            to.m_max = std::max(to.m_max, from.m_max);
+            for (int b = 0; b < NUM_BUCKETS; b++)
+                to.m_histogram[b] += from.m_histogram[b];
+        }
+    }
 
-//-----------------------------------------------------------------------------
-/** Saves all data for the current frame, and starts the next frame in the
- *  circular buffer. Any events that are currently active (e.g. in a separate
- *  thread) will be split in two parts: the beginning (till now) in the current
- *  frame, the rest will be added to the next frame.
- */
-void Profiler::synchronizeFrame()
-{
-}   // synchronizeFrame
+    std::vector<MarkerStats> result;
+    for (unsigned int i = 0; i < all_event_data.size(); i++)
+    {
+        const EventData &ed = all_event_data[i];
+        if (ed.m_count == 0) continue;
+        MarkerStats ms;
+        ms.m_name  = m_all_event_names[i];
+        ms.m_count = ed.m_count;
+        ms.m_total = ed.m_total;
+        ms.m_mean  = ed.m_total / ed.m_count;
+        ms.m_max   = ed.m_max;
+        double *percentile[2] = { &ms.m_p50, &ms.m_p99 };
+        const double fraction[2] = { 0.5, 0.99 };
+        for (int p = 0; p < 2; p++)
+        {
+            const double n = fraction[p] * ed.m_count;
+            unsigned int sum = 0;
+            int b = 0;
+            for (; b < NUM_BUCKETS - 1; b++)
+            {
+                sum += ed.m_histogram[b];
+                if (sum >= n) break;
+            }
+            // Center of the bucket (in log space), converted to ms
+            *percentile[p] = b == 0 ? 0.0005
+                : pow(10.0, (b - 0.5) / BUCKETS_PER_DECADE) / 1000.0;
+            *percentile[p] = std::min(*percentile[p], ed.m_max);
+        }
+        result.push_back(ms);
+    }
+    return result;
+}   // getStats
 
 //-----------------------------------------------------------------------------
-/** Saves the collected profile data to a file. Filename is based on the
- *  stdout name (with -profile appended).
- */
-void Profiler::writeToFile()
+/** Returns all recorded events in the Chrome trace event format. */
+std::string Profiler::getTraceJSON()
 {
-    std::string base_name =
-               file_manager->getUserConfigFile(file_manager->getStdoutName());
-    // First CPU data
-    for (int thread_id = 0; thread_id < m_threads_used; thread_id++)
+    std::lock_guard<std::mutex> lock(m_lock);
+    // Escape the marker names once
+    std::vector<std::string> names;
+    for (const std::string &name : m_all_event_names)
     {
-        std::ofstream f(FileUtils::getPortableWritingPath(
-            base_name + ".profile-cpu-" + StringUtils::toString(thread_id)));
-        ThreadData &td = m_all_threads_data[thread_id];
-        f << "#  ";
-        for (unsigned int i = 0; i < td.m_ordered_headings.size(); i++)
-            f << "\"" << td.m_ordered_headings[i] << "(" << i+1 <<")\"   ";
-        f << std::endl;
-        int start = m_has_wrapped_around ? m_current_frame + 1 : 0;
-        if (start > m_max_frames) start -= m_max_frames;
-        while (start != m_current_frame)
+        std::string escaped;
+        for (char c : name)
         {
-            for (unsigned int i = 0; i < td.m_ordered_headings.size(); i++)
-            {
-                const EventData &ed = td.m_all_event_data[td.m_ordered_headings[i]];
-                f << int(ed.getMarker(start).getDuration()*1000) << " ";
-            }   // for i i new_headings
-            f << std::endl;
-            start = (start + 1) % m_max_frames;
-        }   // while start != m_current_frame
-        f.close();
-    }   // for all thread_ids
-
-    std::ofstream f_gpu(FileUtils::getPortableWritingPath(base_name + ".profile-gpu"));
-    f_gpu << "# ";
-
-    for (unsigned i = 0; i < Q_LAST; i++)
-    {
-        f_gpu << "\"" << "(" << i+1 << ")\"   ";
-    }   // for i < Q_LAST
-    f_gpu << std::endl;
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            if ((unsigned char)c >= 0x20)
+                escaped += c;
+        }
+        names.push_back(escaped);
+    }
 
-    int start = m_has_wrapped_around ? m_current_frame + 1 : 0;
-    if (start > m_max_frames) start -= m_max_frames;
-    while (start != m_current_frame)
+    std::ostringstream out;
+    out.precision(3);
+    out << std::fixed << "{\"traceEvents\":[";
+    bool first = true;
+    for (auto &td : m_all_thread_data)
     {
-        for (unsigned i = 0; i < Q_LAST; i++)
+        std::lock_guard<std::mutex> thread_lock(td->m_lock);
+        for (const TraceEvent &te : td->m_trace_events)
         {
-            f_gpu << m_gpu_times[start*Q_LAST + i] << "   ";
-        }   // for i < Q_LAST
-        f_gpu << std::endl;
-        start = (start + 1) % m_max_frames;
+            out << (first ? "\n" : ",\n")
+                << "{\"name\":\"" << names[te.m_event] << "\",\"ph\":\"X\""
+                << ",\"pid\":0,\"tid\":" << te.m_thread
+                << ",\"ts\":" << (te.m_start - m_time_origin) * 1000.0
+                << ",\"dur\":" << te.m_duration * 1000.0 << "}";
+            first = false;
+        }
     }
-    f_gpu.close();
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out.str();
+}   // getTraceJSON
 
-}   // writeFile
+//-----------------------------------------------------------------------------
+/** Saves all recorded events in the Chrome trace event format. */
+void Profiler::writeTrace(const std::string &filename)
+{
+    std::ofstream f(filename);
+    if (!f)
+        throw std::invalid_argument("Cannot write profiler trace to '" +
+                                    filename + "'");
+    f << getTraceJSON();
+}   // writeTrace
@@ -21,15 +21,13 @@
 #include <irrlicht.h>
 
 #include <assert.h>
-#include <iostream>
-#include <list>
-#include <map>
-#include <ostream>
-#include <stack>
-#include <streambuf>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <vector>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 enum QueryPerf
 {
@@ -64,230 +62,171 @@ extern Profiler profiler;
 
 double getTimeMilliseconds();
 
-// #define ENABLE_PROFILER
-
-#ifdef ENABLE_PROFILER
-    #define PROFILER_PUSH_CPU_MARKER(name, r, g, b) \
-        profiler.pushCPUMarker(name, video::SColor(0xFF, r, g, b))
-
-    #define PROFILER_POP_CPU_MARKER()  \
-        profiler.popCPUMarker()
-
-    #define PROFILER_SYNC_FRAME()   \
-        profiler.synchronizeFrame()
-
-    #define PROFILER_DRAW() \
-        profiler.draw()
-#else
-    #define PROFILER_PUSH_CPU_MARKER(name, r, g, b)
-    #define PROFILER_POP_CPU_MARKER()
-    #define PROFILER_SYNC_FRAME()
-    #define PROFILER_DRAW()
-#endif
+// The markers are always compiled in. While the profiler is disabled they
+// only cost a test of a flag. The name is resolved once per call site, so
+// it must be a string literal (use pushCPUMarker(name) for other names). The
+// colour is kept for compatibility with the old on-screen profiler and is
+// ignored.
+#define PROFILER_PUSH_CPU_MARKER(name, r, g, b)                         \
+    do {                                                                \
+        if (profiler.isEnabled())                                       \
+        {                                                               \
+            static const int profiler_event =                           \
+                profiler.getEventIndex(name);                           \
+            profiler.pushCPUMarker(profiler_event);                     \
+        }                                                               \
+    } while (0)
+
+#define PROFILER_POP_CPU_MARKER()                                       \
+    do { if (profiler.isEnabled()) profiler.popCPUMarker(); } while (0)
+
+/** Pushes a marker for the rest of the current scope, e.g. in a function
+ *  with several return statements. The marker is popped if and only if it
+ *  was pushed, even if the profiler is enabled or disabled in between. */
+#define PROFILER_SCOPED_CPU_MARKER(name)                                \
+    static const int profiler_scope_event = profiler.getEventIndex(name); \
+    ProfilerScope profiler_scope(profiler_scope_event)
 
 using namespace irr;
 
 // ============================================================================
-/** \brief class that allows run-time graphical profiling through the use 
- *  of markers.
+/** \brief Collects timing statistics of (nested) CPU markers. For each marker
+ *  name the number of calls, the total time and a histogram of the durations
+ *  (used to compute percentiles) is accumulated. Optionally all events are
+ *  recorded as well, so that they can be exported in the Chrome trace event
+ *  format (chrome://tracing or https://ui.perfetto.dev).
+ *  The profiler is disabled by default, see enable().
  * \ingroup utils
  */
 class Profiler
 {
-private:
-    // ------------------------------------------------------------------------
-    class Marker
+public:
+    /** Aggregated statistics of a marker, all times are in milliseconds. */
+    struct MarkerStats
     {
-    private:
-        /** An event that is started (pushed) stores the start time in this
-         *  variable. */
-        double  m_start;
+        std::string m_name;
+        unsigned int m_count;
+        double m_total, m_mean, m_p50, m_p99, m_max;
+    };   // MarkerStats
 
-        /** Duration of the event in this frame (accumulated if this event
-         *  should be recorded more than once). */
-
-        double  m_duration;
-        /** Distance of marker from root (for nested events), used to
-         *  adjust vertical height when drawing. */
-        size_t  m_layer;
-    public:
-        // --------------------------------------------------------------------
-        Marker() { m_start = 0; m_duration = 0; m_layer = 0; }
-
-        // --------------------------------------------------------------------
-        Marker(double start, size_t layer=0)
-           : m_start(start), m_duration(0), m_layer(layer)
-        {
-        }
-        // --------------------------------------------------------------------
-        Marker(const Marker& ref)
-            : m_start(ref.m_start), m_duration(ref.m_duration), 
-              m_layer(ref.m_layer)
-        {
-        }
-        // --------------------------------------------------------------------
-        /** Returns the start time of this event marker. */
-        double getStart() const { return m_start;  }
-        // --------------------------------------------------------------------
-        /** Returns the end time of this event marker. */
-        double getEnd() const { return m_start+m_duration; }
-        // --------------------------------------------------------------------
-        /** Returns the duration of this event. */
-        double getDuration() const { return m_duration;  }
-        // --------------------------------------------------------------------
-        size_t getLayer() const { return m_layer;  }
-        // --------------------------------------------------------------------
-        /** Called when an entry in the cyclic buffer is reused. Makes sure
-         *  that time for a new event can be accumulated. */
-        void clear() { m_duration = 0; }
-        // --------------------------------------------------------------------
-        /** Sets start time and layer for this event. */
-        void setStart(double start, size_t layer = 0)
-        {
-            m_start = start; m_layer = layer;
-        }   // setStart
-        // --------------------------------------------------------------------
-        /** Sets the end time of this event. */
-        void setEnd(double end)
-        {
-            m_duration += (end - m_start);
-        }   // setEnd
+private:
+    /** Number of histogram buckets per decade. Percentiles are accurate to
+     *  about 6%. */
+    static const int BUCKETS_PER_DECADE = 20;
 
-    };   // class Marker
+    /** The histogram covers 1 microsecond to 100 seconds, shorter and longer
+     *  events are counted in the first respectively last bucket. */
+    static const int NUM_BUCKETS = 8 * BUCKETS_PER_DECADE + 2;
 
-    // ========================================================================
-    /** The data for one event. It contains the events colours, all markers
-     * for the buffer period and a stack to detect nesting of markers.
-     */
-    class EventData
+    // ------------------------------------------------------------------------
+    /** All data collected for one marker name. */
+    struct EventData
     {
-    private:
-        /** Colour to use in the on-screen display */
-        video::SColor m_colour;
-
-        /** Vector of all buffered markers. */
-        std::vector<Marker> m_all_markers;
-
-    public:
-        EventData() {}
-        EventData(video::SColor colour, int max_size)
-        {
-            m_all_markers.resize(max_size);
-            m_colour = colour;
-        }   // EventData
-        // --------------------------------------------------------------------
-        /** Records the start of an event for a given frame. */
-        void setStart(size_t frame, double start, int layer)
-        {
-            assert(frame < m_all_markers.capacity());
-            m_all_markers[frame].setStart(start, layer);
-        }   // setStart
-        // --------------------------------------------------------------------
-        /** Records the end of an event for a given frame. */
-        void setEnd(size_t frame, double end)
-        {
-            assert(frame < m_all_markers.capacity());
-            m_all_markers[frame].setEnd(end);
-        }   // setEnd
-        // --------------------------------------------------------------------
-        const Marker& getMarker(int n) const { return m_all_markers[n]; }
-        Marker& getMarker(int n) { return m_all_markers[n]; }
-        // --------------------------------------------------------------------
-        /** Returns the colour for this event. */
-        video::SColor getColour() const { return m_colour;  }
-        // --------------------------------------------------------------------
+        unsigned int m_count;
+        double m_total, m_max;
+        std::vector<unsigned int> m_histogram;
+        EventData() : m_count(0), m_total(0), m_max(0),
+                      m_histogram(NUM_BUCKETS, 0) {}
     };   // EventData
 
-    // ========================================================================
-    /** The mapping of event names to the corresponding EventData. */
-    typedef std::map<std::string, EventData> AllEventData;
-    // ========================================================================
-    struct ThreadData
+    // ------------------------------------------------------------------------
+    /** One recorded event for the trace export. */
+    struct TraceEvent
     {
-        /** Stack of events to detect nesting. */
-        std::vector< std::string > m_event_stack;
-
-        /** This stores the event names in the order in which they occur.
-        *  This means that 'outer' events occur here before any child
-        *  events. This list is then used to determine the order in which the
-        *  bar graphs are drawn, which results in the proper nesting of events.*/
-        std::vector<std::string> m_ordered_headings;
-
-        AllEventData m_all_event_data;
-    };   // class ThreadData
-
-    // ========================================================================
-
-    /** Data structure containing all currently buffered markers. The index
-     *  is the thread id. */
-    std::vector< ThreadData> m_all_threads_data;
-
-    /** A mapping of thread_t pointers to a unique integer (starting from 0).*/
-    std::vector<std::thread::id> m_thread_mapping;
-
-    /** Buffer for the GPU times (in ms). */
-    std::vector<int> m_gpu_times;
-
-    /** Counts the threads used, i.e. registered in m_thread_mapping. */
-    int m_threads_used;
+        int m_event, m_thread;
+        double m_start, m_duration;
+    };   // TraceEvent
 
-    /** Index of the current frame in the buffer. */
-    int m_current_frame;
-
-    /** We don't need the bool, but easiest way to get a lock for the whole
-     *  instance (since we need to avoid that a synch is done which changes
-     *  the current frame while another threaded uses this variable, or
-     *  while a new thread is added. */
-    bool m_lock;
-
-    /** True if the circular buffer has wrapped around. */
-    bool m_has_wrapped_around;
-
-    /** The maximum number of frames to be buffered. Used to minimise
-     *  reallocations. */
-    int m_max_frames;
-
-    /** Time of last sync. All start/end times are stored relative
-     *  to this time. */
-    double m_time_last_sync;
-
-    /** Time between now and last sync, used to scale the GUI bar. */
-    double m_time_between_sync;
-
-    /** List of all event names. This list is sorted to make sure
-     *  if the circular buffer is dumped more than once the order
-     *  of events remains the same. */
+    // ------------------------------------------------------------------------
+    /** The markers recorded by one thread. Only this thread pushes and pops
+     *  markers, so m_lock is only contended while the data is read. */
+    struct ThreadData
+    {
+        /** Index of the thread in the trace. */
+        int m_thread;
+        /** The currently active markers: index and start time. */
+        std::vector<std::pair<int, double> > m_stack;
+        /** Value of Profiler::m_generation when m_stack was filled. */
+        unsigned int m_generation;
+        /** Protects the data below. */
+        std::mutex m_lock;
+        /** Statistics, indexed like m_all_event_names. */
+        std::vector<EventData> m_event_data;
+        std::vector<TraceEvent> m_trace_events;
+    };   // ThreadData
+
+    /** True if markers are recorded. */
+    std::atomic<bool> m_enabled;
+
+    /** Changed by each enable() and disable(), markers pushed before are
+     *  dropped (they might never be popped). */
+    std::atomic<unsigned int> m_generation;
+
+    /** True if each event is recorded for the trace export. */
+    std::atomic<bool> m_trace;
+
+    /** Number of recorded trace events (of all threads), and the number of
+     *  events that were not recorded since there were too many. */
+    std::atomic<size_t> m_num_trace_events, m_dropped_trace_events;
+    size_t m_max_trace_events;
+
+    /** Protects all data below, which is only changed when a new marker
+     *  name or thread is seen. */
+    std::mutex m_lock;
+
+    /** Maps a marker name to its index in m_all_event_names. */
+    std::unordered_map<std::string, int> m_event_index;
     std::vector<std::string> m_all_event_names;
 
-    // Handling freeze/unfreeze by clicking on the display
-    enum FreezeState
-    {
-        UNFROZEN,
-        WAITING_FOR_FREEZE,
-        FROZEN,
-        WAITING_FOR_UNFREEZE,
-    };
+    /** The data of all threads which recorded a marker. */
+    std::vector<std::unique_ptr<ThreadData> > m_all_thread_data;
 
-    FreezeState     m_freeze_state;
+    /** All times are relative to this time (in ms). */
+    double m_time_origin;
 
-private:
-    int  getThreadID();
-    void drawBackground();
+    ThreadData *getThreadData();
 
 public:
              Profiler();
     virtual ~Profiler();
-    void     init();
-    void     pushCPUMarker(const char* name="N/A",
-                           const video::SColor& color=video::SColor());
+    void     enable(bool trace = false, size_t max_trace_events = 1000000);
+    void     disable();
+    void     reset();
+    int      getEventIndex(const char* name);
+    void     pushCPUMarker(int event);
+    void     pushCPUMarker(const char* name="N/A");
     void     popCPUMarker();
-    void     toggleStatus(); 
-    void     synchronizeFrame();
-    void     writeToFile();
-
+    std::vector<MarkerStats> getStats();
+    std::string getTraceJSON();
+    void     writeTrace(const std::string &filename);
     // ------------------------------------------------------------------------
-    bool isFrozen() const { return m_freeze_state == FROZEN; }
+    bool isEnabled() const
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }   // isEnabled
+    // ------------------------------------------------------------------------
+    /** Returns the number of events which were not recorded for the trace,
+     *  since the maximum number of events was reached. */
+    size_t getDroppedTraceEvents() const { return m_dropped_trace_events; }
 
-};
+};   // Profiler
+
+// ============================================================================
+/** Pushes a CPU marker on construction and pops it on destruction. */
+class ProfilerScope
+{
+private:
+    bool m_pushed;
+public:
+    ProfilerScope(int event) : m_pushed(profiler.isEnabled())
+    {
+        if (m_pushed) profiler.pushCPUMarker(event);
+    }   // ProfilerScope
+    // ------------------------------------------------------------------------
+    ~ProfilerScope()
+    {
+        if (m_pushed) profiler.popCPUMarker();
+    }   // ~ProfilerScope
+};   // ProfilerScope
 
 #endif // PROFILER_HPP
@@ -29,3 +29,23 @@ RandomGenerator::RandomGenerator(int s)
 {
     seed(s);
 }   // RandomGenerator
+
+// ----------------------------------------------------------------------------
+/** Derives the seed of a random stream from the seed of a world. The result
+ *  only depends on the arguments (a counter based hash, splitmix64), so each
+ *  stream (and each index in a stream, e.g. the kart id) is reproducible and
+ *  independent of the order in which the streams are created or used.
+ *  \param seed The seed of the world (see RaceManager::getRandomSeed).
+ *  \param stream Which stream to derive the seed for.
+ *  \param index Index of the stream, e.g. the world kart id.
+ */
+uint32_t RandomGenerator::deriveSeed(uint32_t seed, RandomStream stream,
+                                     uint32_t index)
+{
+    uint64_t z = ((uint64_t)seed << 32) | ((uint64_t)stream << 24);
+    z += 0x9E3779B97F4A7C15ull * ((uint64_t)index + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return (uint32_t)(z >> 32);
+}   // deriveSeed
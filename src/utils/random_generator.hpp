@@ -20,6 +20,7 @@
 #define HEADER_RANDOM_GENERATOR_HPP
 
 #include <algorithm>
+#include <cstdint>
 #include <vector>
 #include <stdlib.h>
 #include <random>
@@ -33,6 +34,17 @@
  */
 class RandomGenerator
 {
+public:
+    /** Independent streams of random numbers used in a world, see
+     *  deriveSeed. Appending new streams does not change existing ones. */
+    enum RandomStream
+    {
+        RS_ITEMS = 0,
+        RS_POWERUPS,
+        RS_AI,
+        RS_SCRIPT
+    };
+
 private:
     std::mt19937 engine;
 
@@ -40,6 +52,9 @@ public:
     RandomGenerator();
     RandomGenerator(int seed);
 
+    static uint32_t deriveSeed(uint32_t seed, RandomStream stream,
+                               uint32_t index = 0);
+
     //std::vector<int> generateAllSeeds();
     /** Returns a pseudo random number between 0 and n-1 inclusive */
     int  get(int n)  {return engine() % n; }
@@ -0,0 +1,113 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2020 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef HEADER_SNAPSHOT_HPP
+#define HEADER_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/** A flat binary buffer used to save and restore the simulation state of a
+ *  world (see World::saveState). Values are copied byte by byte, so a
+ *  snapshot is only valid in the process (and for the world) that created
+ *  it. Reads have to happen in exactly the same order as the writes.
+ */
+class Snapshot
+{
+private:
+    /** The raw data. */
+    std::string m_data;
+
+    /** Current read position. */
+    size_t m_pos;
+
+    // ------------------------------------------------------------------------
+    void read(void *dst, size_t n)
+    {
+        if (m_pos + n > m_data.size())
+            throw std::runtime_error("Snapshot: read past the end of the data");
+        memcpy(dst, m_data.data() + m_pos, n);
+        m_pos += n;
+    }   // read
+
+public:
+    Snapshot() : m_pos(0) {}
+    // ------------------------------------------------------------------------
+    Snapshot(const std::string &data) : m_data(data), m_pos(0) {}
+    // ------------------------------------------------------------------------
+    /** Appends a plain data value (e.g. int, float, Vec3, btTransform). */
+    template<typename T> void add(const T &v)
+    {
+        static_assert(std::is_standard_layout<T>::value &&
+                      std::is_trivially_destructible<T>::value,
+                      "Snapshot can only store plain data types");
+        m_data.append((const char*)&v, sizeof(T));
+    }   // add
+    // ------------------------------------------------------------------------
+    /** Reads a value that was written with add(). */
+    template<typename T> void get(T *v)
+    {
+        static_assert(std::is_standard_layout<T>::value &&
+                      std::is_trivially_destructible<T>::value,
+                      "Snapshot can only store plain data types");
+        read(v, sizeof(T));
+    }   // get
+    // ------------------------------------------------------------------------
+    template<typename T> T get()
+    {
+        T v;
+        get(&v);
+        return v;
+    }   // get
+    // ------------------------------------------------------------------------
+    /** Appends a vector of plain data values, including its size. */
+    template<typename T> void add(const std::vector<T> &v)
+    {
+        add<uint32_t>((uint32_t)v.size());
+        for (const T &e : v)
+            add(e);
+    }   // add
+    // ------------------------------------------------------------------------
+    void add(const std::vector<bool> &v)
+    {
+        add<uint32_t>((uint32_t)v.size());
+        for (bool e : v)
+            add(e);
+    }   // add
+    // ------------------------------------------------------------------------
+    /** Reads a vector, the size of the stored vector has to match. */
+    template<typename T> void get(std::vector<T> *v)
+    {
+        if (get<uint32_t>() != v->size())
+            throw std::runtime_error("Snapshot: size mismatch");
+        for (unsigned int i = 0; i < v->size(); i++)
+            (*v)[i] = get<T>();
+    }   // get
+    // ------------------------------------------------------------------------
+    /** Returns the content of this snapshot. */
+    const std::string &getData() const { return m_data; }
+    // ------------------------------------------------------------------------
+    /** True if all data has been read. */
+    bool isEnd() const { return m_pos == m_data.size(); }
+};   // Snapshot
+
+#endif
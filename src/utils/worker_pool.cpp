@@ -0,0 +1,125 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2006-2015 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#include "utils/worker_pool.hpp"
+
+WorkerPool *WorkerPool::m_worker_pool = NULL;
+
+// ----------------------------------------------------------------------------
+WorkerPool::WorkerPool(unsigned int num_workers)
+{
+    m_job        = NULL;
+    m_job_size   = 0;
+    m_next_item  = 0;
+    m_generation = 0;
+    m_busy       = 0;
+    m_exit       = false;
+    for (unsigned int i = 0; i < num_workers; i++)
+        m_threads.emplace_back(&WorkerPool::mainLoop, this);
+}   // WorkerPool
+
+// ----------------------------------------------------------------------------
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exit = true;
+    }
+    m_start_cv.notify_all();
+    for (std::thread &thread : m_threads)
+        thread.join();
+}   // ~WorkerPool
+
+// ----------------------------------------------------------------------------
+/** The loop of each worker thread: waits for a new job, works on it and
+ *  signals when it is done.
+ */
+void WorkerPool::mainLoop()
+{
+    unsigned int generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start_cv.wait(lock, [this, generation]()
+                {
+                    return m_exit || m_generation != generation;
+                });
+            if (m_exit)
+                return;
+            generation = m_generation;
+        }
+        work();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_busy--;
+            if (m_busy == 0)
+                m_done_cv.notify_one();
+        }
+    }
+}   // mainLoop
+
+// ----------------------------------------------------------------------------
+/** Processes items of the current job until none are left. */
+void WorkerPool::work()
+{
+    while (true)
+    {
+        unsigned int i = m_next_item.fetch_add(1);
+        if (i >= m_job_size)
+            return;
+        (*m_job)(i);
+    }
+}   // work
+
+// ----------------------------------------------------------------------------
+/** Calls job(i) for all i in [0, n) using all threads of the pool, and
+ *  returns once all calls are finished.
+ *  \param n Number of items.
+ *  \param job The function to call for each item.
+ */
+void WorkerPool::parallelFor(unsigned int n,
+                             const std::function<void(unsigned int)> &job)
+{
+    if (n == 0)
+        return;
+    if (n == 1 || m_threads.empty())
+    {
+        for (unsigned int i = 0; i < n; i++)
+            job(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job       = &job;
+        m_job_size  = n;
+        m_next_item = 0;
+        m_busy      = (unsigned int)m_threads.size();
+        m_generation++;
+    }
+    m_start_cv.notify_all();
+
+    work();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait(lock, [this]() { return m_busy == 0; });
+    m_job = NULL;
+}   // parallelFor
+
+/* EOF */
@@ -0,0 +1,101 @@
+//
+//  SuperTuxKart - a fun racing game with go-kart
+//  Copyright (C) 2006-2015 SuperTuxKart-Team
+//
+//  This program is free software; you can redistribute it and/or
+//  modify it under the terms of the GNU General Public License
+//  as published by the Free Software Foundation; either version 3
+//  of the License, or (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+#ifndef HEADER_WORKER_POOL_HPP
+#define HEADER_WORKER_POOL_HPP
+
+#include "utils/no_copy.hpp"
+
+#include <assert.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief A small pool of worker threads that runs parallel loops.
+ *  parallelFor() hands out the indices of a loop one at a time from a shared
+ *  counter, so threads that finish their items early take over the
+ *  remaining ones. The calling thread works on the loop as well and only
+ *  returns once all items are done. Jobs must not depend on the order in
+ *  which items are processed.
+ * \ingroup utils
+ */
+class WorkerPool : public NoCopy
+{
+private:
+    static WorkerPool *m_worker_pool;
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex               m_mutex;
+    std::condition_variable  m_start_cv;
+    std::condition_variable  m_done_cv;
+
+    /** The job of the current loop, and its number of items. */
+    const std::function<void(unsigned int)> *m_job;
+    unsigned int             m_job_size;
+
+    /** The next item of the current loop to be processed. */
+    std::atomic<unsigned int> m_next_item;
+
+    /** Incremented for each loop, so workers can detect a new job. */
+    unsigned int             m_generation;
+
+    /** Number of workers still working on the current loop. */
+    unsigned int             m_busy;
+
+    /** Set to stop all workers. */
+    bool                     m_exit;
+
+    WorkerPool(unsigned int num_workers);
+    ~WorkerPool();
+    void mainLoop();
+    void work();
+
+public:
+    // ------------------------------------------------------------------------
+    /** Creates the pool. num_threads includes the calling thread, so
+     *  num_threads-1 workers are started. */
+    static void create(unsigned int num_threads)
+    {
+        assert(!m_worker_pool && num_threads > 1);
+        m_worker_pool = new WorkerPool(num_threads - 1);
+    }   // create
+    // ------------------------------------------------------------------------
+    /** Returns the pool, or NULL if parallel updates are disabled. */
+    static WorkerPool* get() { return m_worker_pool; }
+    // ------------------------------------------------------------------------
+    /** Stops all workers and frees the pool. */
+    static void destroy() { delete m_worker_pool; m_worker_pool = NULL; }
+    // ------------------------------------------------------------------------
+    void parallelFor(unsigned int n,
+                     const std::function<void(unsigned int)> &job);
+    // ------------------------------------------------------------------------
+    /** Returns the number of threads, including the calling thread. */
+    unsigned int getNumThreads() const
+    {
+        return (unsigned int)m_threads.size() + 1;
+    }   // getNumThreads
+};   // WorkerPool
+
+#endif
+
+/* EOF */
@@ -182,13 +182,22 @@ def createAcGetter(groups):
 }}  // get{1}
 """.format(m.typeC, nameTitle, nameUnderscore.upper(), typeC, result))
 
+""" The KartProperties getters read from the CompiledCharacteristic table,
+    which hands out views instead of copies for non-scalar types. """
+def kpReturnType(member):
+    if member.typeC == "std::vector<float>":
+        return "FloatSpan"
+    if member.typeC == "InterpolationArray":
+        return "const InterpolationArray&"
+    return member.typeC
+
 def createKpDefs(groups):
     for g in groups:
         print()
         for m in g.members:
             nameTitle = joinSubName(g, m, True)
             nameUnderscore = joinSubName(g, m, False)
-            typeC = m.typeC
+            typeC = kpReturnType(m)
 
             print("    {0} get{1}() const;".
                 format(typeC, nameTitle, nameUnderscore))
@@ -198,15 +207,16 @@ def createKpGetter(groups):
         for m in g.members:
             nameTitle = joinSubName(g, m, True)
             nameUnderscore = joinSubName(g, m, False)
-            typeC = m.typeC
-            result = "result"
+            typeC = kpReturnType(m)
+            getter = "get" + "".join(w.title() for w in toList(m.typeStr))
 
             print("""// ----------------------------------------------------------------------------
 {1} KartProperties::get{0}() const
 {{
-    return m_cached_characteristic->get{0}();
+    return m_compiled_characteristic.{2}(
+        AbstractCharacteristic::{3});
 }}  // get{0}
-""".format(nameTitle, typeC))
+""".format(nameTitle, typeC, getter, nameUnderscore.upper()))
 
 def createGetType(groups):
     for g in groups: